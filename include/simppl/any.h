@@ -180,11 +180,8 @@ class Any
         {
             if (iter.msg_)
             {
-                std::ostringstream oss;
-                Codec<T>::make_type_signature(oss);
-
                 std::unique_ptr<char, void(*)(void*)> sig(dbus_message_iter_get_signature(const_cast<DBusMessageIter*>(&iter.iter_)), &dbus_free);
-                return !strcmp(sig.get(), oss.str().c_str());
+                return !strcmp(sig.get(), detail::type_signature<T>());
             }
 
             return false;
@@ -210,17 +207,17 @@ class Any
         {
             if (iter.msg_)
             {
-                std::ostringstream oss;
-                Codec<T>::make_type_signature(oss);
-
                 std::unique_ptr<char, void(*)(void*)> sig(dbus_message_iter_get_signature(const_cast<DBusMessageIter*>(&iter.iter_)), &dbus_free);
 
                 // TODO some better exception message: expected ..., provided ...
-                if (strcmp(sig.get(), oss.str().c_str()))
+                if (strcmp(sig.get(), detail::type_signature<T>()))
                     throw std::runtime_error("Invalid type");
 
                 // make a copy, so the method may be called multiple times
                 DBusMessageIter __iter = iter.iter_;
+
+                // the signature matches, no need to check each element
+                detail::ValidatedDecoding scope;
                 return detail::deserialize_and_return_from_iter<T>::eval(const_cast<DBusMessageIter*>(&__iter));
             }
 
@@ -255,11 +252,8 @@ class Any
     static
     void encoder(DBusMessageIter& iter, const T& data)
     {
-        std::ostringstream buf;
-        Codec<T>::make_type_signature(buf);
-
         DBusMessageIter iter2;
-        dbus_message_iter_open_container(&iter, DBUS_TYPE_VARIANT, buf.str().c_str(), &iter2);
+        dbus_message_iter_open_container(&iter, DBUS_TYPE_VARIANT, detail::type_signature<T>(), &iter2);
 
         Codec<T>::encode(iter2, data);
 
@@ -389,7 +383,7 @@ struct Codec<Any>
     void decode(DBusMessageIter& orig, Any& v)
     {
         DBusMessageIter iter;
-        simppl_dbus_message_iter_recurse(&orig, &iter, DBUS_TYPE_VARIANT);
+        detail::iter_recurse(&orig, &iter, DBUS_TYPE_VARIANT);
 
         // FIXME TODO XXX take the message from the codec calls since this is
         // highly implementation dependent
@@ -404,6 +398,13 @@ struct Codec<Any>
     {
         return os << DBUS_TYPE_VARIANT_AS_STRING;
     }
+
+
+    static constexpr
+    auto signature()
+    {
+        return detail::make_fixed_string(DBUS_TYPE_VARIANT_AS_STRING);
+    }
 };
 
 }   // dbus
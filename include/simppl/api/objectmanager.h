@@ -7,6 +7,7 @@
 #include "simppl/vector.h"
 #include "simppl/objectpath.h"
 #include "simppl/any.h"
+#include "simppl/string.h"
 
 
 namespace org
@@ -46,4 +47,36 @@ namespace org
 }
 
 
+namespace simppl
+{
+    namespace dbus
+    {
+        namespace ext
+        {
+            using simppl::dbus::in;
+            using simppl::dbus::out;
+
+
+            /**
+             * simppl extension implemented by each object manager to page
+             * through large numbers of managed objects. The objects are
+             * ordered by their path, a page starts after the given path, the
+             * first page after the empty string. A page shorter than requested
+             * is the last one.
+             */
+            INTERFACE(ObjectManager)
+            {
+                Method<in<std::string>, in<uint32_t>, out<org::freedesktop::DBus::managed_objects_t>> GetManagedObjectsPaged;
+
+                ObjectManager()
+                 : INIT(GetManagedObjectsPaged)
+                {
+                    // NOOP
+                }
+            };
+        }
+    }
+}
+
+
 #endif   // __SIMPPL_ORG_FREEDESKTOP_DBUS_OBJECTMANAGER_H__
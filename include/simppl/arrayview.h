@@ -0,0 +1,253 @@
+#ifndef SIMPPL_DBUS_ARRAYVIEW_H
+#define SIMPPL_DBUS_ARRAYVIEW_H
+
+
+#include <cstddef>
+#include <utility>
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#   include <span>
+#endif
+
+#include "simppl/serialization.h"
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+/**
+ * Read-only view on an array of fixed-size elements. A received view points
+ * straight into the D-Bus message and holds a reference on it, so the data is
+ * not copied and stays valid as long as the view or one of its copies lives.
+ *
+ * A view may also be constructed on arbitrary memory for sending, then
+ * the memory must outlive the view.
+ */
+template<typename T>
+class ArrayView
+{
+   static_assert(detail::is_fixed_array_element<T>::value, "not a fixed-size element type");
+
+   friend struct Codec<ArrayView<T>>;
+
+public:
+
+   typedef T value_type;
+   typedef const T* const_iterator;
+
+   inline
+   ArrayView()
+    : msg_(nullptr)
+    , data_(nullptr)
+    , size_(0)
+   {
+      // NOOP
+   }
+
+   /**
+    * No copy of data.
+    */
+   inline
+   ArrayView(const T* data, std::size_t size)
+    : msg_(nullptr)
+    , data_(data)
+    , size_(size)
+   {
+      // NOOP
+   }
+
+   inline
+   ArrayView(const ArrayView& rhs)
+    : msg_(rhs.msg_)
+    , data_(rhs.data_)
+    , size_(rhs.size_)
+   {
+      if (msg_)
+         dbus_message_ref(msg_);
+   }
+
+   inline
+   ArrayView(ArrayView&& rhs)
+    : msg_(std::exchange(rhs.msg_, nullptr))
+    , data_(std::exchange(rhs.data_, nullptr))
+    , size_(std::exchange(rhs.size_, 0))
+   {
+      // NOOP
+   }
+
+   inline
+   ~ArrayView()
+   {
+      if (msg_)
+         dbus_message_unref(msg_);
+   }
+
+   inline
+   ArrayView& operator=(ArrayView rhs)
+   {
+      std::swap(msg_, rhs.msg_);
+      std::swap(data_, rhs.data_);
+      std::swap(size_, rhs.size_);
+
+      return *this;
+   }
+
+   inline
+   const T* data() const
+   {
+      return data_;
+   }
+
+   inline
+   std::size_t size() const
+   {
+      return size_;
+   }
+
+   inline
+   bool empty() const
+   {
+      return size_ == 0;
+   }
+
+   inline
+   const T& operator[](std::size_t idx) const
+   {
+      return data_[idx];
+   }
+
+   inline
+   const_iterator begin() const
+   {
+      return data_;
+   }
+
+   inline
+   const_iterator end() const
+   {
+      return data_ + size_;
+   }
+
+private:
+
+   DBusMessage* msg_;
+   const T* data_;
+   std::size_t size_;
+};
+
+
+/// received byte arrays without copying, e.g. for just inspecting headers
+typedef ArrayView<uint8_t> BufferView;
+
+
+template<typename T>
+struct Codec<ArrayView<T>>
+{
+   static inline
+   void encode(DBusMessageIter& iter, const ArrayView<T>& v)
+   {
+      detail::append_fixed_array(iter, v.data(), v.size());
+   }
+
+
+   static inline
+   void encode(detail::WireWriter& w, const ArrayView<T>& v)
+   {
+      w.write_fixed_array(v.data(), v.size());
+   }
+
+
+   static inline
+   void decode(DBusMessageIter& iter, ArrayView<T>& v)
+   {
+      // FIXME the message should be passed by the caller since this is
+      // highly implementation dependent, see Any
+      DBusMessage* msg = (DBusMessage*)iter.dummy1;
+
+      const T* data;
+      std::size_t size = detail::get_fixed_array(iter, data);
+
+      dbus_message_ref(msg);
+      v = ArrayView<T>();
+
+      v.msg_ = msg;
+      v.data_ = data;
+      v.size_ = size;
+   }
+
+
+   static inline
+   std::ostream& make_type_signature(std::ostream& os)
+   {
+      return Codec<T>::make_type_signature(os << DBUS_TYPE_ARRAY_AS_STRING);
+   }
+
+
+   static constexpr
+   auto signature()
+   {
+      return detail::make_fixed_string(DBUS_TYPE_ARRAY_AS_STRING) + Codec<T>::signature();
+   }
+};
+
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+
+/**
+ * Like ArrayView but without reference on the message, so the span is only
+ * valid as long as the message, i.e. within the callback.
+ */
+template<typename T>
+struct Codec<std::span<const T>>
+{
+   static_assert(detail::is_fixed_array_element<T>::value, "not a fixed-size element type");
+
+   static inline
+   void encode(DBusMessageIter& iter, std::span<const T> s)
+   {
+      detail::append_fixed_array(iter, s.data(), s.size());
+   }
+
+
+   static inline
+   void encode(detail::WireWriter& w, std::span<const T> s)
+   {
+      w.write_fixed_array(s.data(), s.size());
+   }
+
+
+   static inline
+   void decode(DBusMessageIter& iter, std::span<const T>& s)
+   {
+      const T* data;
+      std::size_t size = detail::get_fixed_array(iter, data);
+
+      s = std::span<const T>(data, size);
+   }
+
+
+   static inline
+   std::ostream& make_type_signature(std::ostream& os)
+   {
+      return Codec<T>::make_type_signature(os << DBUS_TYPE_ARRAY_AS_STRING);
+   }
+
+
+   static constexpr
+   auto signature()
+   {
+      return detail::make_fixed_string(DBUS_TYPE_ARRAY_AS_STRING) + Codec<T>::signature();
+   }
+};
+
+#endif   // __cplusplus >= 202002L
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+#endif   // SIMPPL_DBUS_ARRAYVIEW_H
@@ -17,11 +17,23 @@ struct BoolCodec
    static 
    void encode(DBusMessageIter& iter, bool b);
 
+   static inline
+   void encode(detail::WireWriter& w, bool b)
+   {
+      w.write<uint32_t>(b);
+   }
+
    static 
    void decode(DBusMessageIter& iter, bool& t);
    
    static
    std::ostream& make_type_signature(std::ostream& os);
+
+   static constexpr
+   auto signature()
+   {
+      return detail::make_fixed_string(DBUS_TYPE_BOOLEAN_AS_STRING);
+   }
 };
    
 
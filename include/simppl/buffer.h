@@ -104,7 +104,7 @@ struct Codec<FixedSizeBuffer<len>>
    void decode(DBusMessageIter& iter, FixedSizeBuffer<len>& b)
    {
       DBusMessageIter _iter;
-      simppl_dbus_message_iter_recurse(&iter, &_iter, DBUS_TYPE_ARRAY);
+      detail::iter_recurse(&iter, &_iter, DBUS_TYPE_ARRAY);
       
       unsigned char* buf; 
       int _len = len;
@@ -120,7 +120,14 @@ struct Codec<FixedSizeBuffer<len>>
    static inline
    std::ostream& make_type_signature(std::ostream& os)
    {
-      return os << DBUS_TYPE_ARRAY_AS_STRING;
+      return os << DBUS_TYPE_ARRAY_AS_STRING DBUS_TYPE_BYTE_AS_STRING;
+   }
+
+
+   static constexpr
+   auto signature()
+   {
+      return detail::make_fixed_string(DBUS_TYPE_ARRAY_AS_STRING DBUS_TYPE_BYTE_AS_STRING);
    }
 };
 
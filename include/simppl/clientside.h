@@ -178,7 +178,7 @@ struct ClientPropertyWritableMixin : ClientPropertyBase
 
       return detail::InterimCallbackHolder<holder_type>(that->stub_->set_property_async(that->name_, [&t](DBusMessageIter& s){
          detail::PropertyCodec<data_type>::encode(s, t);
-      }));
+      }), that->stub_->callback_pool());
    }
 };
 
@@ -214,7 +214,7 @@ struct ClientProperty
 
    detail::InterimCallbackHolder<holder_type> get_async()
    {
-      return detail::InterimCallbackHolder<holder_type>(this->stub_->get_property_async(this->name_));
+      return detail::InterimCallbackHolder<holder_type>(this->stub_->get_property_async(this->name_), this->stub_->callback_pool());
    }
 
 
@@ -272,13 +272,18 @@ ClientProperty<DataT, Flags>& ClientProperty<DataT, Flags>::attach()
 {
   this->stub_->attach_property(this);
 
+  auto f = [this](const CallState& cs, const arg_type& val){
+     if (f_)
+        f_(cs, val);
+  };
+
+  typedef typename holder_type::template rebind<decltype(f)> lambda_holder_type;
+  detail::CallbackPool& pool = this->stub_->callback_pool();
+
   dbus_pending_call_set_notify(this->stub_->get_property_async(this->name_).pending(),
-     &holder_type::pending_notify,
-     new holder_type([this](const CallState& cs, const arg_type& val){
-        if (f_)
-           f_(cs, val);
-     }),
-     &holder_type::_delete);
+     &lambda_holder_type::pending_notify,
+     pool.make<lambda_holder_type>(pool, f),
+     &lambda_holder_type::_delete);
 
   return *this;
 }
@@ -353,8 +358,8 @@ struct ClientMethod : ClientMethodBase
       static_assert(std::is_convertible<typename detail::canonify<std::tuple<T...>>::type,
                     args_type>::value, "args mismatch");
 
-      auto msg = parent_->send_request_and_block(this, [&](DBusMessageIter& s){
-         serializer_type::eval(s, t...);
+      auto msg = parent_->send_request_and_block(this, [&](message_ptr_t& msg){
+         serializer_type::eval(msg, t...);
       }, is_oneway);
 
       return detail::deserialize_and_return<return_type>::eval(msg.get());
@@ -369,9 +374,9 @@ struct ClientMethod : ClientMethodBase
       static_assert(std::is_convertible<typename detail::canonify<std::tuple<typename std::decay<T>::type...>>::type,
                     args_type>::value, "args mismatch");
 
-      return detail::InterimCallbackHolder<holder_type>(parent_->send_request(this, [&](DBusMessageIter& s){
-         serializer_type::eval(s, t...);
-      }, false));
+      return detail::InterimCallbackHolder<holder_type>(parent_->send_request(this, [&](message_ptr_t& msg){
+         serializer_type::eval(msg, t...);
+      }, false), parent_->callback_pool());
    }
 
 
@@ -410,8 +415,10 @@ template<typename HolderT, typename FunctorT>
 inline
 simppl::dbus::PendingCall operator>>(simppl::dbus::detail::InterimCallbackHolder<HolderT>&& r, const FunctorT& f)
 {
-   // TODO static_assert FunctorT and HolderT::f_ convertible?
-   dbus_pending_call_set_notify(r.pc_.pending(), &HolderT::pending_notify, new HolderT(f), &HolderT::_delete);
+   // store the functor itself, no need for another allocation within a std::function
+   typedef typename HolderT::template rebind<typename std::decay<FunctorT>::type> holder_type;
+
+   dbus_pending_call_set_notify(r.pc_.pending(), &holder_type::pending_notify, r.pool_.template make<holder_type>(r.pool_, f), &holder_type::_delete);
 
    return std::move(r.pc_);
 }
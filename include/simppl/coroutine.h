@@ -0,0 +1,473 @@
+#ifndef SIMPPL_COROUTINE_H
+#define SIMPPL_COROUTINE_H
+
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <dbus/dbus.h>
+
+#include "simppl/dispatcher.h"
+#include "simppl/error.h"
+#include "simppl/pendingcall.h"
+#include "simppl/serverrequestdescriptor.h"
+#include "simppl/skeletonbase.h"
+#include "simppl/stubbase.h"
+#include "simppl/threadpool.h"
+
+#include "simppl/detail/holders.h"
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+// forward decl
+template<typename T = void>
+struct Task;
+
+
+namespace detail
+{
+
+// forward decl
+template<typename MethodT, typename TaskT>
+struct TaskResponder;
+
+
+/**
+ * Suspends the awaiting coroutine until the reply of a pending call has
+ * arrived. The coroutine is resumed from within the dispatcher's eventloop.
+ * The awaiter lives within the coroutine frame, so no further allocation
+ * is necessary.
+ */
+struct PendingCallAwaiter
+{
+   explicit inline
+   PendingCallAwaiter(PendingCall&& pc)
+    : pc_(std::move(pc))
+   {
+      // NOOP
+   }
+
+   PendingCallAwaiter(const PendingCallAwaiter&) = delete;
+   PendingCallAwaiter& operator=(const PendingCallAwaiter&) = delete;
+
+   inline
+   bool await_ready()
+   {
+      // no pending call if the request could not be sent
+      return !pc_.pending() || dbus_pending_call_get_completed(pc_.pending());
+   }
+
+   inline
+   void await_suspend(std::coroutine_handle<> h)
+   {
+      handle_ = h;
+      dbus_pending_call_set_notify(pc_.pending(), &pending_notify, this, nullptr);
+   }
+
+protected:
+
+   message_ptr_t steal_reply()
+   {
+      if (!pc_.pending())
+         throw Error(DBUS_ERROR_DISCONNECTED);
+
+      return make_message(dbus_pending_call_steal_reply(pc_.pending()));
+   }
+
+private:
+
+   static
+   void pending_notify(DBusPendingCall*, void* data)
+   {
+      ((PendingCallAwaiter*)data)->handle_.resume();
+   }
+
+   PendingCall pc_;
+   std::coroutine_handle<> handle_;
+};
+
+
+template<typename HolderT>
+struct CallAwaiter : PendingCallAwaiter
+{
+   using PendingCallAwaiter::PendingCallAwaiter;
+
+   typename HolderT::return_type await_resume()
+   {
+      auto msg = steal_reply();
+      return HolderT::eval_response(*msg);
+   }
+};
+
+
+struct GetAllPropertiesAwaiter : PendingCallAwaiter
+{
+   inline
+   GetAllPropertiesAwaiter(PendingCall&& pc, StubBase& stub)
+    : PendingCallAwaiter(std::move(pc))
+    , stub_(stub)
+   {
+      // NOOP
+   }
+
+   void await_resume()
+   {
+      auto msg = steal_reply();
+      GetAllPropertiesHolder::eval_response(stub_, *msg);
+   }
+
+   StubBase& stub_;
+};
+
+
+/// co_await stub.method.async(args...) or co_await stub.prop.get_async()
+template<typename HolderT>
+inline
+CallAwaiter<HolderT> operator co_await(InterimCallbackHolder<HolderT>&& r)
+{
+   return CallAwaiter<HolderT>(std::move(r.pc_));
+}
+
+
+/// co_await stub.get_all_properties.async()
+inline
+GetAllPropertiesAwaiter operator co_await(InterimGetAllPropertiesCallbackHolder&& r)
+{
+   return GetAllPropertiesAwaiter(std::move(r.pc_), r.stub_);
+}
+
+
+struct TaskPromiseBase
+{
+   struct FinalAwaiter
+   {
+      bool await_ready() noexcept
+      {
+         return false;
+      }
+
+      template<typename PromiseT>
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<PromiseT> h) noexcept
+      {
+         auto& promise = h.promise();
+
+         // nobody is interested in the result anymore
+         if (promise.detached_)
+         {
+            h.destroy();
+            return std::noop_coroutine();
+         }
+
+         return promise.continuation_ ? promise.continuation_ : std::noop_coroutine();
+      }
+
+      void await_resume() noexcept
+      {
+         // NOOP
+      }
+   };
+
+   std::suspend_never initial_suspend() noexcept
+   {
+      return {};
+   }
+
+   FinalAwaiter final_suspend() noexcept
+   {
+      return {};
+   }
+
+   void unhandled_exception()
+   {
+      exception_ = std::current_exception();
+   }
+
+   void rethrow()
+   {
+      if (exception_)
+         std::rethrow_exception(exception_);
+   }
+
+   std::coroutine_handle<> continuation_;
+   std::exception_ptr exception_;
+   bool detached_ = false;
+};
+
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase
+{
+   Task<T> get_return_object();
+
+   void return_value(T t)
+   {
+      value_.emplace(std::move(t));
+   }
+
+   T result()
+   {
+      rethrow();
+      return std::move(*value_);
+   }
+
+   std::optional<T> value_;
+};
+
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase
+{
+   Task<void> get_return_object();
+
+   void return_void()
+   {
+      // NOOP
+   }
+
+   void result()
+   {
+      rethrow();
+   }
+};
+
+}   // namespace detail
+
+
+/**
+ * Return type of coroutines. The coroutine starts immediately and runs until
+ * its first suspension point. A Task may be awaited by another coroutine.
+ * It may also just be dropped, then the coroutine runs to completion on its
+ * own and an exception escaping the coroutine is silently discarded.
+ *
+ * Tasks are not thread-safe: a coroutine switching threads via resume_on()
+ * must not complete concurrently with the coroutine awaiting it.
+ */
+template<typename T>
+struct Task
+{
+   typedef detail::TaskPromise<T> promise_type;
+   typedef T value_type;
+
+   Task(const Task&) = delete;
+   Task& operator=(const Task&) = delete;
+
+   explicit inline
+   Task(std::coroutine_handle<promise_type> h)
+    : handle_(h)
+   {
+      // NOOP
+   }
+
+   inline
+   Task(Task&& rhs) noexcept
+    : handle_(std::exchange(rhs.handle_, nullptr))
+   {
+      // NOOP
+   }
+
+   inline
+   Task& operator=(Task&& rhs) noexcept
+   {
+      if (this != &rhs)
+      {
+         reset();
+         handle_ = std::exchange(rhs.handle_, nullptr);
+      }
+
+      return *this;
+   }
+
+   inline
+   ~Task()
+   {
+      reset();
+   }
+
+   inline
+   bool done() const
+   {
+      return !handle_ || handle_.done();
+   }
+
+   // awaitable interface
+
+   inline
+   bool await_ready() const noexcept
+   {
+      return handle_.done();
+   }
+
+   inline
+   void await_suspend(std::coroutine_handle<> h) noexcept
+   {
+      handle_.promise().continuation_ = h;
+   }
+
+   inline
+   T await_resume()
+   {
+      return handle_.promise().result();
+   }
+
+private:
+
+   void reset()
+   {
+      if (handle_)
+      {
+         if (handle_.done())
+         {
+            handle_.destroy();
+         }
+         else
+            handle_.promise().detached_ = true;
+
+         handle_ = nullptr;
+      }
+   }
+
+   std::coroutine_handle<promise_type> handle_;
+};
+
+
+namespace detail
+{
+
+template<typename T>
+inline
+Task<T> TaskPromise<T>::get_return_object()
+{
+   return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+
+inline
+Task<void> TaskPromise<void>::get_return_object()
+{
+   return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+
+/**
+ * Adapts a coroutine request handler of a ServerMethod: the request is
+ * deferred and answered as soon as the handler's Task completes.
+ */
+template<typename MethodT, typename R>
+struct TaskResponder<MethodT, Task<R>>
+{
+   template<typename FuncT>
+   static
+   auto wrap(MethodT& method, const FuncT& f)
+   {
+      return [&method, f](auto&&... args){
+         respond(method, method.parent_->defer_response(), f(args...));
+      };
+   }
+
+   static
+   Task<> respond(MethodT& method, ServerRequestDescriptor req, Task<R> task)
+   {
+      try
+      {
+         if constexpr (MethodT::is_oneway)
+         {
+            co_await task;
+         }
+         else if constexpr (std::is_void_v<R>)
+         {
+            co_await task;
+            method.parent_->respond_on(req, method());
+         }
+         else
+         {
+            R rc = co_await task;
+
+            // multiple out values are returned as tuple
+            if constexpr (std::tuple_size_v<typename MethodT::return_type_generator::type> > 1)
+            {
+               std::apply([&method, &req](const auto&... t){
+                  method.parent_->respond_on(req, method(t...));
+               }, rc);
+            }
+            else
+               method.parent_->respond_on(req, method(rc));
+         }
+      }
+      catch(const Error& err)
+      {
+         if (req)
+            method.parent_->respond_on(req, err);
+      }
+      catch(...)
+      {
+         if (req)
+            method.parent_->respond_on(req, Error("simppl.dbus.UnhandledException"));
+      }
+   }
+};
+
+
+template<typename ExecutorT>
+struct ResumeOnAwaiter
+{
+   bool await_ready() noexcept
+   {
+      return false;
+   }
+
+   void await_suspend(std::coroutine_handle<> h)
+   {
+      executor_.post([h](){ h.resume(); });
+   }
+
+   void await_resume() noexcept
+   {
+      // NOOP
+   }
+
+   ExecutorT& executor_;
+};
+
+}   // namespace detail
+
+
+/**
+ * co_await resume_on(disp) continues the coroutine on the thread running
+ * the dispatcher's eventloop.
+ */
+inline
+detail::ResumeOnAwaiter<Dispatcher> resume_on(Dispatcher& disp)
+{
+   return { disp };
+}
+
+
+/**
+ * co_await resume_on(pool) continues the coroutine on one of the pool's
+ * worker threads, e.g. for CPU-heavy work.
+ */
+inline
+detail::ResumeOnAwaiter<ThreadPool> resume_on(ThreadPool& pool)
+{
+   return { pool };
+}
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+#endif   // __cplusplus >= 202002L
+
+#endif   // SIMPPL_COROUTINE_H
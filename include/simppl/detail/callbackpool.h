@@ -0,0 +1,96 @@
+#ifndef SIMPPL_DETAIL_CALLBACKPOOL_H
+#define SIMPPL_DETAIL_CALLBACKPOOL_H
+
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+namespace detail
+{
+
+/**
+ * Freelist allocator for the callback holders of asynchronous calls. Blocks
+ * are recycled in size classes of 64 bytes up to 512 bytes, larger holders
+ * are directly allocated from the heap.
+ *
+ * Holders are usually created on the calling thread and destroyed on the
+ * dispatcher thread, so the pool is thread-safe. Pending calls may outlive
+ * their dispatcher, therefore the pool is not deleted before the last block
+ * has been returned.
+ */
+struct CallbackPool
+{
+   CallbackPool(const CallbackPool&) = delete;
+   CallbackPool& operator=(const CallbackPool&) = delete;
+
+   CallbackPool();
+
+   /**
+    * Drop the owner's reference.
+    */
+   void release();
+
+   void* allocate(std::size_t size);
+   void deallocate(void* p, std::size_t size);
+
+   template<typename T, typename... ArgsT>
+   T* make(ArgsT&&... args)
+   {
+      void* p = allocate(sizeof(T));
+
+      try
+      {
+         return new(p) T(std::forward<ArgsT>(args)...);
+      }
+      catch(...)
+      {
+         deallocate(p, sizeof(T));
+         throw;
+      }
+   }
+
+   template<typename T>
+   void destroy(T* t)
+   {
+      t->~T();
+      deallocate(t, sizeof(T));
+   }
+
+private:
+
+   ~CallbackPool();
+
+   static constexpr std::size_t granularity = 64;
+   static constexpr std::size_t classes = 8;
+
+   struct Block
+   {
+      Block* next_;
+   };
+
+   void unref();
+
+   std::mutex mutex_;
+   Block* free_[classes];
+
+   std::atomic_int refs_;   ///< owner and outstanding blocks
+};
+
+}   // namespace detail
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+#endif   // SIMPPL_DETAIL_CALLBACKPOOL_H
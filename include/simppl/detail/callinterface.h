@@ -84,12 +84,26 @@ struct FunctionCaller<0, std::tuple<>>
 template<typename T>
 struct DeserializeAndCall : simppl::NonInstantiable
 {
+   static inline
+   const char* signature()
+   {
+      return args_signature<T>();
+   }
+
+   /**
+    * @param validated the message signature was already checked, so skip
+    *        the type checks of the single elements.
+    */
    template<typename FunctorT>
    static
-   void eval(DBusMessageIter& iter, FunctorT& f)
+   void eval(DBusMessageIter& iter, FunctorT& f, bool validated = false)
    {
       std::tuple<T> tuple;
-      Codec<std::tuple<T>>::decode_flattened(iter, tuple);
+
+      {
+         ValidatedDecoding scope(validated);
+         Codec<std::tuple<T>>::decode_flattened(iter, tuple);
+      }
 
       FunctionCaller<0, std::tuple<T>>::template eval(f, tuple);
    }
@@ -111,12 +125,26 @@ struct DeserializeAndCall : simppl::NonInstantiable
 template<typename... T>
 struct DeserializeAndCall<std::tuple<T...>> : simppl::NonInstantiable
 {
+   static inline
+   const char* signature()
+   {
+      return args_signature<T...>();
+   }
+
+   /**
+    * @param validated the message signature was already checked, so skip
+    *        the type checks of the single elements.
+    */
    template<typename FunctorT>
    static inline
-   void eval(DBusMessageIter& iter, FunctorT& f)
+   void eval(DBusMessageIter& iter, FunctorT& f, bool validated = false)
    {
       std::tuple<T...> tuple;
-      Codec<std::tuple<T...>>::decode_flattened(iter, tuple);
+
+      {
+         ValidatedDecoding scope(validated);
+         Codec<std::tuple<T...>>::decode_flattened(iter, tuple);
+      }
 
       FunctionCaller<0, std::tuple<T...>>::template eval(f, tuple);
    }
@@ -137,9 +165,15 @@ struct DeserializeAndCall<std::tuple<T...>> : simppl::NonInstantiable
 
 struct DeserializeAndCall0 : simppl::NonInstantiable
 {
+   static inline
+   const char* signature()
+   {
+      return "";
+   }
+
    template<typename FunctorT>
    static inline
-   void eval(DBusMessageIter& /*iter*/, FunctorT& f)
+   void eval(DBusMessageIter& /*iter*/, FunctorT& f, bool /*validated*/ = false)
    {
       f();
    }
@@ -0,0 +1,84 @@
+#ifndef SIMPPL_DETAIL_DISPATCHINDEX_H
+#define SIMPPL_DETAIL_DISPATCHINDEX_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+namespace detail
+{
+
+/**
+ * Open addressing hash table mapping (interface, member) to the method or
+ * property implementing it, so the lookup cost of incoming requests does
+ * not depend on the number of interfaces and members of an object. The
+ * members are given as offsets, see InterfaceTable.
+ *
+ * The table does not copy the names, they must outlive the index.
+ */
+struct DispatchIndex
+{
+   enum Kind : uint8_t
+   {
+      Interface,   ///< member is empty
+      Method,
+      Property
+   };
+
+   struct Entry
+   {
+      std::size_t hash_;
+      const char* iface_;    ///< nullptr for empty slots
+      const char* member_;
+      std::ptrdiff_t offset_;
+      int iface_id_;
+      Kind kind_;
+   };
+
+   DispatchIndex();
+
+   void clear();
+
+   inline
+   bool empty() const
+   {
+      return size_ == 0;
+   }
+
+   /**
+    * Insert the entry unless the key is already there.
+    */
+   void insert(Kind kind, const char* iface, const char* member, int iface_id, std::ptrdiff_t offset);
+
+   /**
+    * @return the entry or nullptr if not found.
+    */
+   const Entry* find(Kind kind, const char* iface, const char* member) const;
+
+private:
+
+   static
+   std::size_t hash(Kind kind, const char* iface, const char* member);
+
+   void rehash(std::size_t capacity);
+
+   std::vector<Entry> entries_;   ///< power of two sized
+   std::size_t size_;
+};
+
+}   // namespace detail
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+#endif   // SIMPPL_DETAIL_DISPATCHINDEX_H
@@ -0,0 +1,82 @@
+#ifndef SIMPPL_DETAIL_FIXEDSTRING_H
+#define SIMPPL_DETAIL_FIXEDSTRING_H
+
+
+#include <cstddef>
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+namespace detail
+{
+
+/**
+ * Null-terminated string of fixed length usable in constant expressions.
+ * Used for building the D-Bus type signatures of the codecs at compile time.
+ */
+template<std::size_t N>
+struct FixedString
+{
+   constexpr
+   const char* c_str() const
+   {
+      return str_;
+   }
+
+   static constexpr
+   std::size_t size()
+   {
+      return N;
+   }
+
+   char str_[N + 1];
+};
+
+
+template<std::size_t N>
+constexpr
+FixedString<N - 1> make_fixed_string(const char (&str)[N])
+{
+   FixedString<N - 1> rc{};
+
+   for (std::size_t i = 0; i < N - 1; ++i)
+      rc.str_[i] = str[i];
+
+   return rc;
+}
+
+
+constexpr
+FixedString<1> make_fixed_string(char c)
+{
+   return FixedString<1>{ { c, '\0' } };
+}
+
+
+template<std::size_t N, std::size_t M>
+constexpr
+FixedString<N + M> operator+(const FixedString<N>& lhs, const FixedString<M>& rhs)
+{
+   FixedString<N + M> rc{};
+
+   for (std::size_t i = 0; i < N; ++i)
+      rc.str_[i] = lhs.str_[i];
+
+   for (std::size_t i = 0; i < M; ++i)
+      rc.str_[N + i] = rhs.str_[i];
+
+   return rc;
+}
+
+}   // namespace detail
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+#endif   // SIMPPL_DETAIL_FIXEDSTRING_H
@@ -0,0 +1,70 @@
+#ifndef SIMPPL_DETAIL_FUNCTION_REF_H
+#define SIMPPL_DETAIL_FUNCTION_REF_H
+
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+namespace detail
+{
+
+template<typename SignatureT>
+class function_ref;
+
+
+/**
+ * Non-owning reference to a callable. Unlike std::function it never
+ * allocates, but the referenced callable must outlive the function_ref.
+ * It is therefore only suitable for parameters of functions calling the
+ * callable before returning.
+ */
+template<typename R, typename... ArgsT>
+class function_ref<R(ArgsT...)>
+{
+public:
+
+   template<typename FuncT, typename = typename std::enable_if<
+      !std::is_same<typename std::decay<FuncT>::type, function_ref>::value>::type>
+   inline
+   function_ref(FuncT&& f) noexcept
+    : obj_((void*)std::addressof(f))
+    , cb_(&invoke<typename std::remove_reference<FuncT>::type>)
+   {
+      // NOOP
+   }
+
+   inline
+   R operator()(ArgsT... args) const
+   {
+      return cb_(obj_, std::forward<ArgsT>(args)...);
+   }
+
+private:
+
+   template<typename FuncT>
+   static
+   R invoke(void* obj, ArgsT... args)
+   {
+      return (*(FuncT*)obj)(std::forward<ArgsT>(args)...);
+   }
+
+   void* obj_;
+   R(*cb_)(void*, ArgsT...);
+};
+
+}   // namespace detail
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+#endif   // SIMPPL_DETAIL_FUNCTION_REF_H
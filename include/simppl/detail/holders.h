@@ -4,7 +4,9 @@
 
 #include <variant>
 
+#include "callbackpool.h"
 #include "callinterface.h"
+#include "deserialize_and_return.h"
 
 
 namespace simppl
@@ -27,14 +29,16 @@ struct InterimCallbackHolder
 
    InterimCallbackHolder& operator=(const InterimCallbackHolder&) = delete;
 
-   explicit inline
-   InterimCallbackHolder(const PendingCall& pc)
+   inline
+   InterimCallbackHolder(PendingCall&& pc, CallbackPool& pool)
     : pc_(std::move(pc))
+    , pool_(pool)
    {
       // NOOP
    }
 
    PendingCall pc_;
+   CallbackPool& pool_;
 };
 
 
@@ -42,28 +46,42 @@ struct InterimGetAllPropertiesCallbackHolder
 {
    InterimGetAllPropertiesCallbackHolder& operator=(const InterimGetAllPropertiesCallbackHolder&) = delete;
 
-   InterimGetAllPropertiesCallbackHolder(const PendingCall& pc, StubBase& stub)
+   InterimGetAllPropertiesCallbackHolder(PendingCall&& pc, StubBase& stub, CallbackPool& pool)
     : pc_(std::move(pc))
     , stub_(stub)
+    , pool_(pool)
    {
       // NOOP
    }
 
    PendingCall pc_;
    StubBase& stub_;
+   CallbackPool& pool_;
 };
 
 
+/**
+ * Keeps the user's callback of an asynchronous call. Holders are allocated
+ * from the dispatcher's CallbackPool and store the callback by value, so
+ * rebind the holder to the actual functor type before creating it.
+ */
 template<typename FuncT, typename ReturnT, typename ErrorT>
 struct CallbackHolder
 {
+   typedef ReturnT return_type;
+   typedef ErrorT  error_type;
+
+   template<typename OtherFuncT>
+   using rebind = CallbackHolder<OtherFuncT, ReturnT, ErrorT>;
+
    CallbackHolder(const CallbackHolder&) = delete;
    CallbackHolder& operator=(const CallbackHolder&) = delete;
 
 
-   explicit inline
-   CallbackHolder(const FuncT& f)
-    : f_(std::move(f))
+   inline
+   CallbackHolder(CallbackPool& pool, const FuncT& f)
+    : f_(f)
+    , pool_(pool)
    {
       // NOOP
    }
@@ -72,7 +90,7 @@ struct CallbackHolder
    void _delete(void* p)
    {
       auto that = (CallbackHolder*)p;
-      delete that;
+      that->pool_.destroy(that);
    }
 
    static
@@ -81,7 +99,6 @@ struct CallbackHolder
        auto msg = simppl::dbus::make_message(dbus_pending_call_steal_reply(pc));
 
        auto that = (CallbackHolder*)data;
-       assert(that->f_);
 
        TCallState<ErrorT> cs(*msg);
 
@@ -91,20 +108,43 @@ struct CallbackHolder
        GetCaller<ReturnT>::type::template evalResponse(iter, that->f_, cs);
    }
 
+   /// decode the response or throw the error, e.g. for coroutines
+   static
+   ReturnT eval_response(DBusMessage& msg)
+   {
+       if (dbus_message_get_type(&msg) == DBUS_MESSAGE_TYPE_ERROR)
+       {
+           ErrorT err;
+           ErrorFactory<ErrorT>::init(err, msg);
+
+           throw err;
+       }
+
+       return deserialize_and_return<ReturnT>::eval(&msg);
+   }
+
    FuncT f_;
+   CallbackPool& pool_;
 };
 
 
 template<typename FuncT, typename DataT>
 struct PropertyCallbackHolder
 {
+   typedef DataT return_type;
+   typedef Error error_type;
+
+   template<typename OtherFuncT>
+   using rebind = PropertyCallbackHolder<OtherFuncT, DataT>;
+
    PropertyCallbackHolder(const PropertyCallbackHolder&) = delete;
    PropertyCallbackHolder& operator=(const PropertyCallbackHolder&) = delete;
 
 
-   explicit inline
-   PropertyCallbackHolder(const FuncT& f)
+   inline
+   PropertyCallbackHolder(CallbackPool& pool, const FuncT& f)
     : f_(f)
+    , pool_(pool)
    {
       // NOOP
    }
@@ -113,7 +153,7 @@ struct PropertyCallbackHolder
    void _delete(void* p)
    {
       auto that = (PropertyCallbackHolder*)p;
-      delete that;
+      that->pool_.destroy(that);
    }
 
    static
@@ -122,7 +162,6 @@ struct PropertyCallbackHolder
       auto msg = simppl::dbus::make_message(dbus_pending_call_steal_reply(pc));
 
        auto that = (PropertyCallbackHolder*)data;
-       assert(that->f_);
 
        simppl::dbus::CallState cs(*msg);
        if (cs)
@@ -139,7 +178,29 @@ struct PropertyCallbackHolder
           that->f_(cs, DataT());
    }
 
+   /// decode the response or throw the error, e.g. for coroutines
+   static
+   DataT eval_response(DBusMessage& msg)
+   {
+       if (dbus_message_get_type(&msg) == DBUS_MESSAGE_TYPE_ERROR)
+       {
+           Error err;
+           ErrorFactory<Error>::init(err, msg);
+
+           throw err;
+       }
+
+       DBusMessageIter iter;
+       dbus_message_iter_init(&msg, &iter);
+
+       std::variant<DataT> v;
+       decode(iter, v);
+
+       return std::move(std::get<DataT>(v));
+   }
+
    FuncT f_;
+   CallbackPool& pool_;
 };
 
 
@@ -149,7 +210,7 @@ struct GetAllPropertiesHolder
    GetAllPropertiesHolder& operator=(const GetAllPropertiesHolder&) = delete;
 
 
-   GetAllPropertiesHolder(std::function<void(const CallState&)> f, StubBase& stub);
+   GetAllPropertiesHolder(CallbackPool& pool, std::function<void(const CallState&)> f, StubBase& stub);
 
    static
    void _delete(void* p);
@@ -157,8 +218,13 @@ struct GetAllPropertiesHolder
    static
    void pending_notify(DBusPendingCall* pc, void* data);
 
+   /// evaluate the response or throw the error, e.g. for coroutines
+   static
+   void eval_response(StubBase& stub, DBusMessage& msg);
+
    std::function<void(const CallState&)> f_;
    StubBase& stub_;
+   CallbackPool& pool_;
 };
 
 
@@ -0,0 +1,57 @@
+#ifndef SIMPPL_DETAIL_INTERFACETABLE_H
+#define SIMPPL_DETAIL_INTERFACETABLE_H
+
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "simppl/detail/dispatchindex.h"
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+namespace detail
+{
+
+/**
+ * Metadata of the interfaces implemented by a skeleton type: the interface
+ * names, the members of each interface and the dispatch index. The table is
+ * built once per Skeleton type and shared by all its instances, therefore
+ * members are addressed by their byte offset relative to the SkeletonBase.
+ */
+struct InterfaceTable
+{
+   struct Interface
+   {
+      std::string name_;
+
+      std::vector<std::ptrdiff_t> methods_;
+      std::vector<std::ptrdiff_t> properties_;
+      std::vector<std::ptrdiff_t> signals_;   ///< only filled with introspection support
+   };
+
+   InterfaceTable()
+    : has_properties_(false)
+   {
+      // NOOP
+   }
+
+   std::vector<Interface> ifaces_;   ///< indexed by interface id
+   DispatchIndex index_;             ///< keyed by (interface, member), yields member offsets
+   std::string introspection_;       ///< XML of all interfaces, only filled with introspection support
+   bool has_properties_;
+};
+
+}   // namespace detail
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+#endif   // SIMPPL_DETAIL_INTERFACETABLE_H
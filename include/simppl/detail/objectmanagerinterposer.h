@@ -36,9 +36,12 @@ struct ObjectManagerInterposer
 {
     typedef typename make_server_type<org::freedesktop::DBus::ObjectManager>::type objectmanager_server_type;
 
-    enum { avail = Find<objectmanager_server_type, typename make_typelist<typename make_server_type<Is>::type...>::type>::value != -1 };
+    /// same as Skeleton::interface_list
+    typedef make_typelist<typename make_server_type<Is>::type...> key_type;
 
-    typedef typename std::conditional<avail, SizedObjectManagerMixin<sizeof...(Is)>, SizedSkeletonBase<sizeof...(Is)>>::type type;
+    enum { avail = Find<objectmanager_server_type, typename key_type::type>::value != -1 };
+
+    typedef typename std::conditional<avail, SizedObjectManagerMixin<sizeof...(Is), key_type>, SizedSkeletonBase<sizeof...(Is), key_type>>::type type;
 };
 
 #else
@@ -49,7 +52,10 @@ struct ObjectManagerInterposer
 template<template<int, template<typename...> class, template<typename...> class, template<typename, int> class, typename> class... Is>
 struct ObjectManagerInterposer
 {
-    typedef SizedSkeletonBase<sizeof...(Is)> type;
+    /// same as Skeleton::interface_list
+    typedef make_typelist<typename make_server_type<Is>::type...> key_type;
+
+    typedef SizedSkeletonBase<sizeof...(Is), key_type> type;
 };
 
 #endif   // SIMPPL_HAVE_OBJECTMANAGER
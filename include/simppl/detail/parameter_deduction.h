@@ -8,6 +8,7 @@
 
 #include "simppl/typelist.h"
 #include "simppl/callstate.h"
+#include "simppl/detail/wire.h"
 
 
 namespace simppl
@@ -139,9 +140,9 @@ template<typename...T>
 struct SerializerGenerator
 {
    static inline
-   void eval(DBusMessageIter& s, const T&... t)
+   void eval(message_ptr_t& msg, const T&... t)
    {
-      encode(s, t...);
+      encode_message(msg, t...);
    }
 };
 
@@ -2,15 +2,13 @@
 #define SIMPPL_DETAIL_SERVERRESPONSEHOLDER_H
 
 
-#include <functional>
 #include <cstdint>
+#include <new>
+#include <type_traits>
 
 #include <sys/types.h>
 
-
-// forward decl
-struct DBusMessage;
-struct DBusMessageIter;
+#include "simppl/types.h"
 
 
 namespace simppl
@@ -23,9 +21,32 @@ namespace detail
 {
 
 
+/**
+ * Keeps the serializer of a response. The serializer only references the
+ * out values given to ServerMethod::operator(), so it is stored inline and
+ * the holder must be consumed within the same full-expression, i.e.
+ * respond_with(method(args...)).
+ */
 struct ServerResponseHolder 
 {
-   ServerResponseHolder(std::function<void(DBusMessageIter&)> f);
+   /// response without out values
+   inline
+   ServerResponseHolder()
+    : cb_(nullptr)
+   {
+      // NOOP
+   }
+
+   template<typename FuncT>
+   ServerResponseHolder(const FuncT& f)
+    : cb_(&invoke<FuncT>)
+   {
+      static_assert(sizeof(FuncT) <= sizeof(storage_), "too many out values");
+      static_assert(std::is_trivially_copyable<FuncT>::value && std::is_trivially_destructible<FuncT>::value,
+                    "serializer must only capture references");
+
+      new(storage_) FuncT(f);
+   }
    
    ~ServerResponseHolder();
    
@@ -35,7 +56,29 @@ struct ServerResponseHolder
    ServerResponseHolder(const ServerResponseHolder& rhs) = delete;
    ServerResponseHolder& operator=(const ServerResponseHolder& rhs) = delete;
    
-   std::function<void(DBusMessageIter&)> f_;
+   explicit inline
+   operator bool() const
+   {
+      return cb_ != nullptr;
+   }
+
+   inline
+   void operator()(message_ptr_t& msg) const
+   {
+      cb_(storage_, msg);
+   }
+
+private:
+
+   template<typename FuncT>
+   static
+   void invoke(const void* f, message_ptr_t& msg)
+   {
+      (*(const FuncT*)f)(msg);
+   }
+
+   void(*cb_)(const void*, message_ptr_t&);
+   alignas(void*) unsigned char storage_[16 * sizeof(void*)];
 };
 
 }   // namespace detail
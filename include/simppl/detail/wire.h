@@ -0,0 +1,192 @@
+#ifndef SIMPPL_DETAIL_WIRE_H
+#define SIMPPL_DETAIL_WIRE_H
+
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <dbus/dbus.h>
+
+#include "simppl/types.h"
+#include "simppl/serialization.h"
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+namespace detail
+{
+
+/**
+ * @return the marshalled body of the message, starting 8-byte aligned in
+ *         the native byte order.
+ */
+std::string wire_body(DBusMessage& msg);
+
+/**
+ * Create a message from the header of a template message and an already
+ * marshalled body. The body must match the template's signature and be
+ * marshalled in native byte order, the template's own body is dropped.
+ * The template is locked afterwards and must not be sent anymore.
+ *
+ * @throw RuntimeError if the body is not valid for the signature.
+ */
+message_ptr_t wire_message(DBusMessage& tmpl, const char* body, std::size_t len);
+
+/**
+ * Like above, but for a template without arguments, which therefore has no
+ * signature yet. The signature of the body is added to the header.
+ */
+message_ptr_t wire_message(DBusMessage& tmpl, const char* signature, const char* body, std::size_t len);
+
+
+/**
+ * Create a message from the header of the template message and the arguments
+ * written by the WireWriter instead of appending them one by one through
+ * the message iterators. The result is byte-identical. The template must not
+ * carry any arguments.
+ */
+template<typename... T>
+message_ptr_t wire_encode(DBusMessage& tmpl, const T&... t)
+{
+   static_assert(has_wire_encoding<typename simppl::remove_all_const<T>::type...>::value, "no wire encoding for all argument types");
+
+   WireWriter w;
+   encode(w, t...);
+
+   return wire_message(tmpl, args_signature<typename simppl::remove_all_const<T>::type...>(), w.data(), w.size());
+}
+
+
+/**
+ * Smaller bodies are appended faster through the message iterators than
+ * demarshalled from wire format.
+ */
+constexpr std::size_t wire_encoding_threshold = 4096;
+
+
+/**
+ * @return true if the signature contains arrays of other than fixed-size
+ *         elements, i.e. arrays which are appended element by element.
+ */
+constexpr
+bool has_variable_arrays(const char* sig)
+{
+   for (; *sig; ++sig)
+   {
+      if (*sig == DBUS_TYPE_ARRAY)
+      {
+         switch(sig[1])
+         {
+         case DBUS_TYPE_BYTE:
+         case DBUS_TYPE_INT16:
+         case DBUS_TYPE_UINT16:
+         case DBUS_TYPE_INT32:
+         case DBUS_TYPE_UINT32:
+         case DBUS_TYPE_INT64:
+         case DBUS_TYPE_UINT64:
+         case DBUS_TYPE_DOUBLE:
+            break;
+
+         default:
+            return true;
+         }
+      }
+   }
+
+   return false;
+}
+
+
+/**
+ * @return the minimum distance of two array elements of the given type code
+ *         in wire format.
+ */
+constexpr
+std::size_t wire_min_element_size(char type)
+{
+   switch(type)
+   {
+   case DBUS_TYPE_STRING:
+   case DBUS_TYPE_OBJECT_PATH:
+      // length, terminating zero and padding to the next length
+      return 8;
+
+   default:
+      return wire_alignment(type);
+   }
+}
+
+
+/**
+ * @return a lower bound of the wire size of an argument, computed without
+ *         walking it. Only arrays at the top level are accounted for.
+ */
+template<typename T>
+inline
+std::size_t wire_size_hint(const T&)
+{
+   return 0;
+}
+
+
+template<typename T>
+inline
+std::size_t wire_size_hint(const std::vector<T>& v)
+{
+   return v.size() * wire_min_element_size(signature_v<T>.c_str()[0]);
+}
+
+
+template<typename KeyT, typename ValueT>
+inline
+std::size_t wire_size_hint(const std::map<KeyT, ValueT>& m)
+{
+   return m.size() * wire_alignment(DBUS_DICT_ENTRY_BEGIN_CHAR);
+}
+
+
+/**
+ * Append the arguments to a message without arguments. Messages with large
+ * arrays of variable sized elements are written in wire format and replaced
+ * by the demarshalled message, all others are appended through the message
+ * iterators. The choice is made by the size hints of the arguments, so
+ * arrays nested into other arguments always take the iterator path.
+ */
+template<typename... T>
+void encode_message(message_ptr_t& msg, const T&... t)
+{
+   if constexpr(has_wire_encoding<typename simppl::remove_all_const<T>::type...>::value)
+   {
+      if constexpr((has_variable_arrays(signature_v<typename simppl::remove_all_const<T>::type>.c_str()) || ...))
+      {
+         if ((wire_size_hint(t) + ... + 0) >= wire_encoding_threshold)
+         {
+            WireWriter w;
+            encode(w, t...);
+
+            msg = wire_message(*msg, args_signature<typename simppl::remove_all_const<T>::type...>(), w.data(), w.size());
+            return;
+         }
+      }
+   }
+
+   DBusMessageIter iter;
+   dbus_message_iter_init_append(msg.get(), &iter);
+
+   encode(iter, t...);
+}
+
+}   // namespace detail
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+#endif   // SIMPPL_DETAIL_WIRE_H
@@ -0,0 +1,169 @@
+#ifndef SIMPPL_DETAIL_WIREWRITER_H
+#define SIMPPL_DETAIL_WIREWRITER_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <dbus/dbus-protocol.h>
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+namespace detail
+{
+
+/**
+ * @return the wire format alignment of a value of the given type code.
+ */
+constexpr
+std::size_t wire_alignment(char type)
+{
+   switch(type)
+   {
+   case DBUS_TYPE_INT16:
+   case DBUS_TYPE_UINT16:
+      return 2;
+
+   case DBUS_TYPE_BOOLEAN:
+   case DBUS_TYPE_INT32:
+   case DBUS_TYPE_UINT32:
+   case DBUS_TYPE_UNIX_FD:
+   case DBUS_TYPE_STRING:
+   case DBUS_TYPE_OBJECT_PATH:
+   case DBUS_TYPE_ARRAY:
+      return 4;
+
+   case DBUS_TYPE_INT64:
+   case DBUS_TYPE_UINT64:
+   case DBUS_TYPE_DOUBLE:
+   case DBUS_STRUCT_BEGIN_CHAR:
+   case DBUS_DICT_ENTRY_BEGIN_CHAR:
+      return 8;
+
+   default:
+      // byte, signature, variant
+      return 1;
+   }
+}
+
+
+/**
+ * Writes values in the D-Bus wire format in native byte order into a
+ * contiguous buffer, i.e. a message body starting at an 8-byte boundary.
+ * The codecs drive the writer by their compile-time signatures, there are
+ * no checks whether the written data matches any signature.
+ */
+class WireWriter
+{
+public:
+
+   /// position of an open array, see open_array()
+   struct Array
+   {
+      std::size_t length_pos_;
+      std::size_t start_;
+   };
+
+   inline
+   void align(std::size_t alignment)
+   {
+      buf_.resize((buf_.size() + alignment - 1) & ~(alignment - 1), '\0');
+   }
+
+   template<typename T>
+   inline
+   void write(T t)
+   {
+      align(sizeof(T));
+      buf_.append((const char*)&t, sizeof(T));
+   }
+
+   /// data whose memory layout equals its wire format
+   inline
+   void write_block(const void* data, std::size_t len, std::size_t alignment)
+   {
+      align(alignment);
+      buf_.append((const char*)data, len);
+   }
+
+   /// string and object path
+   inline
+   void write_string(const char* str, std::size_t len)
+   {
+      write<uint32_t>(len);
+      buf_.append(str, len);
+      buf_.push_back('\0');
+   }
+
+   inline
+   void write_signature(const char* sig)
+   {
+      std::size_t len = strlen(sig);
+
+      buf_.push_back((char)len);
+      buf_.append(sig, len + 1);
+   }
+
+   /**
+    * The padding to the elements is written even for empty arrays, but
+    * does not count to the array length.
+    */
+   inline
+   Array open_array(std::size_t element_alignment)
+   {
+      write<uint32_t>(0);
+      std::size_t length_pos = buf_.size() - sizeof(uint32_t);
+
+      align(element_alignment);
+
+      return Array{ length_pos, buf_.size() };
+   }
+
+   inline
+   void close_array(const Array& arr)
+   {
+      uint32_t len = buf_.size() - arr.start_;
+      memcpy(&buf_[arr.length_pos_], &len, sizeof(len));
+   }
+
+   template<typename T>
+   inline
+   void write_fixed_array(const T* data, std::size_t size, std::size_t alignment = sizeof(T))
+   {
+      Array arr = open_array(alignment);
+      write_block(data, size * sizeof(T), 1);
+      close_array(arr);
+   }
+
+   inline
+   const char* data() const
+   {
+      return buf_.data();
+   }
+
+   inline
+   std::size_t size() const
+   {
+      return buf_.size();
+   }
+
+private:
+
+   std::string buf_;
+};
+
+}   // namespace detail
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+#endif   // SIMPPL_DETAIL_WIREWRITER_H
@@ -3,6 +3,8 @@
 
 
 #include <chrono>
+#include <cstdint>
+#include <functional>
 #include <string>
 
 #include <dbus/dbus.h>
@@ -22,9 +24,15 @@ namespace dbus
 struct StubBase;
 struct SkeletonBase;
 struct ObjectManagerMixin;
+struct ObjectManagerClient;
 struct ClientSignalBase;
 struct ObjectPath;
 
+namespace detail
+{
+   struct CallbackPool;
+}
+
 
 void enable_threads();
 
@@ -40,10 +48,33 @@ struct Dispatcher
    friend struct StubBase;
    friend struct SkeletonBase;
    friend struct ObjectManagerMixin;
+   friend struct ObjectManagerClient;
 
    friend void dispatcher_add_stub(Dispatcher&, StubBase&);
    friend void dispatcher_add_skeleton(Dispatcher&, SkeletonBase&);
 
+   /**
+    * Counters of the self-hosted eventloop.
+    */
+   struct Statistics
+   {
+      uint64_t iterations = 0;   ///< eventloop iterations
+      uint64_t messages = 0;     ///< dispatched messages
+      uint64_t timeouts = 0;     ///< expired DBus timeouts
+      uint64_t tasks = 0;        ///< run tasks from post() and post_at()
+
+      inline
+      Statistics& operator+=(const Statistics& rhs)
+      {
+         iterations += rhs.iterations;
+         messages += rhs.messages;
+         timeouts += rhs.timeouts;
+         tasks += rhs.tasks;
+
+         return *this;
+      }
+   };
+
    Dispatcher(const Dispatcher&) = delete;
    Dispatcher& operator=(const Dispatcher&) = delete;
 
@@ -74,12 +105,15 @@ struct Dispatcher
    /**
     * Start self-hosted eventloop. Will do all steps of initialing the
     * DBusConnection callouts for I/O and runs @c step_ms() in a loop.
-    * until @c stop() is called.
+    * until @c stop() is called. The loop blocks until I/O is ready, the
+    * earliest DBus timeout expires or it is explicitly woken up, so an idle
+    * loop does not wake up periodically.
     */
    int run();
 
    /**
-    * Do some IO and dispatch the retrieved messages.
+    * Do some IO and dispatch the retrieved messages. Waits at most
+    * @c duration, a negative duration waits until there is something to do.
     */
    template<typename RepT, typename PeriodT>
    inline
@@ -95,15 +129,33 @@ struct Dispatcher
    void dispatch();
 
    /**
-    * Stop self-hosted eventloop.
+    * Stop self-hosted eventloop. May be called from any thread.
     */
    void stop();
 
+   /**
+    * Run @c task on the thread running the self-hosted eventloop. May be
+    * called from any thread, tasks are run in the order they were posted.
+    * Exceptions thrown by a task are propagated out of @c run().
+    */
+   void post(std::function<void()> task);
+
+   /**
+    * Run @c task on the thread running the self-hosted eventloop as soon as
+    * @c deadline has passed. May be called from any thread.
+    */
+   void post_at(std::chrono::steady_clock::time_point deadline, std::function<void()> task);
+
    /**
     * Self hosted eventloop is running.
     */
    bool is_running() const;
 
+   /**
+    * Snapshot of the eventloop counters. May be called from any thread.
+    */
+   Statistics statistics() const;
+
    DBusHandlerResult try_handle_signal(DBusMessage* msg);
 
    void register_signal(StubBase& stub, ClientSignalBase& sigbase);
@@ -124,6 +176,9 @@ struct Dispatcher
       return *conn_;
    }
 
+   /// allocator for the callback holders of asynchronous calls
+   detail::CallbackPool& callback_pool();
+
 private:
 
    /**
@@ -144,11 +199,18 @@ private:
    /// Remove the client.
    void remove_client(StubBase& clnt);
 
+   /// route PropertiesChanged signals matching the client's match string to the client
+   void add_object_manager_client(ObjectManagerClient& clnt, const std::string& match_string);
+   void remove_object_manager_client(ObjectManagerClient& clnt, const std::string& match_string);
+
    /// add a server
    void add_server(SkeletonBase& server);
 
    void remove_server(SkeletonBase& server);
 
+   /// incremented whenever an object path is (un)registered
+   unsigned int registrations() const;
+
    /// Do a single iteration on the self-hosted mainloop.
    int step_ms(int millis);
 
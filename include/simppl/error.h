@@ -20,6 +20,8 @@ namespace dbus
 // forward decl
 namespace detail {
     template<typename> struct ErrorFactory;
+    template<typename, typename, typename> struct CallbackHolder;
+    template<typename, typename> struct PropertyCallbackHolder;
 }
 
 
@@ -28,6 +30,8 @@ struct Error : public std::exception
     template<typename> friend struct detail::ErrorFactory;
     template<typename> friend struct TCallState;
     template<typename...> friend struct ClientMethod;
+    template<typename, typename, typename> friend struct detail::CallbackHolder;
+    template<typename, typename> friend struct detail::PropertyCallbackHolder;
     friend struct StubBase;
 
     // no copies
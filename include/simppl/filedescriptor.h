@@ -64,6 +64,12 @@ struct FileDescriptorCodec
 
    static
    std::ostream& make_type_signature(std::ostream& os);
+
+   static constexpr
+   auto signature()
+   {
+      return detail::make_fixed_string(DBUS_TYPE_UNIX_FD_AS_STRING);
+   }
 };
 
 
@@ -0,0 +1,217 @@
+#ifndef SIMPPL_DBUS_LAZY_H
+#define SIMPPL_DBUS_LAZY_H
+
+
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <dbus/dbus.h>
+
+#include "simppl/serialization.h"
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+/**
+ * Argument wrapper deferring the decoding of a received argument until it
+ * is accessed by get(). Decoding a message just skips the argument and keeps
+ * a reference on the message, so handlers rejecting a request after looking
+ * at other arguments do not pay for decoding the payload.
+ *
+ * A Lazy may also be constructed from a value for sending. Accessing the value
+ * is not thread-safe.
+ */
+template<typename T>
+class Lazy
+{
+   friend struct Codec<Lazy<T>>;
+
+public:
+
+   typedef T value_type;
+
+   inline
+   Lazy()
+    : msg_(nullptr)
+    , iter_(DBUS_MESSAGE_ITER_INIT_CLOSED)
+    , validated_(false)
+   {
+      // NOOP
+   }
+
+   inline
+   Lazy(const T& t)
+    : msg_(nullptr)
+    , iter_(DBUS_MESSAGE_ITER_INIT_CLOSED)
+    , validated_(false)
+    , value_(t)
+   {
+      // NOOP
+   }
+
+   inline
+   Lazy(T&& t)
+    : msg_(nullptr)
+    , iter_(DBUS_MESSAGE_ITER_INIT_CLOSED)
+    , validated_(false)
+    , value_(std::move(t))
+   {
+      // NOOP
+   }
+
+   inline
+   Lazy(const Lazy& rhs)
+    : msg_(rhs.msg_)
+    , iter_(rhs.iter_)
+    , validated_(rhs.validated_)
+    , value_(rhs.value_)
+   {
+      if (msg_)
+         dbus_message_ref(msg_);
+   }
+
+   inline
+   Lazy(Lazy&& rhs)
+    : msg_(std::exchange(rhs.msg_, nullptr))
+    , iter_(rhs.iter_)
+    , validated_(rhs.validated_)
+    , value_(std::move(rhs.value_))
+   {
+      // NOOP
+   }
+
+   inline
+   ~Lazy()
+   {
+      if (msg_)
+         dbus_message_unref(msg_);
+   }
+
+   inline
+   Lazy& operator=(Lazy rhs)
+   {
+      std::swap(msg_, rhs.msg_);
+      std::swap(iter_, rhs.iter_);
+      std::swap(validated_, rhs.validated_);
+      std::swap(value_, rhs.value_);
+
+      return *this;
+   }
+
+   /**
+    * Decodes the argument on first access.
+    *
+    * @throw DecoderError if the argument does not match the type.
+    */
+   const T& get() const
+   {
+      if (!value_)
+      {
+         T t;
+
+         if (msg_)
+         {
+            // a copy, the iterator may be needed for encoding
+            DBusMessageIter iter = iter_;
+
+            detail::ValidatedDecoding scope(validated_);
+            Codec<T>::decode(iter, t);
+         }
+
+         // only set once decoded, a failure must not leave a bogus value
+         value_.emplace(std::move(t));
+      }
+
+      return *value_;
+   }
+
+   /**
+    * @return true if the argument was not yet decoded.
+    */
+   inline
+   bool deferred() const
+   {
+      return !value_;
+   }
+
+private:
+
+   DBusMessage* msg_;
+   DBusMessageIter iter_;
+   bool validated_;   ///< the message signature was checked on reception
+
+   mutable std::optional<T> value_;
+};
+
+
+template<typename T>
+struct Codec<Lazy<T>>
+{
+   static inline
+   void encode(DBusMessageIter& iter, const Lazy<T>& l)
+   {
+      Codec<T>::encode(iter, l.get());
+   }
+
+
+   template<bool B = detail::has_wire_encoding<T>::value, typename = std::enable_if_t<B>>
+   static inline
+   void encode(detail::WireWriter& w, const Lazy<T>& l)
+   {
+      Codec<T>::encode(w, l.get());
+   }
+
+
+   static inline
+   void decode(DBusMessageIter& iter, Lazy<T>& l)
+   {
+      if constexpr(detail::has_signature<Codec<T>>::value)
+      {
+         // at least check the outermost type
+         constexpr char type = detail::signature_v<T>.c_str()[0];
+
+         if (dbus_message_iter_get_arg_type(&iter) != (type == DBUS_STRUCT_BEGIN_CHAR ? DBUS_TYPE_STRUCT : type))
+            throw DecoderError();
+      }
+
+      // FIXME the message should be passed by the caller since this is
+      // highly implementation dependent, see Any
+      DBusMessage* msg = (DBusMessage*)iter.dummy1;
+      dbus_message_ref(msg);
+
+      l = Lazy<T>();
+      l.msg_ = msg;
+      l.iter_ = iter;
+      l.validated_ = detail::validated_decoding;
+
+      // skip the argument
+      dbus_message_iter_next(&iter);
+   }
+
+
+   static inline
+   std::ostream& make_type_signature(std::ostream& os)
+   {
+      return Codec<T>::make_type_signature(os);
+   }
+
+
+   template<typename CodecT = Codec<T>>
+   static constexpr
+   auto signature() -> decltype(CodecT::signature())
+   {
+      return CodecT::signature();
+   }
+};
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+#endif   // SIMPPL_DBUS_LAZY_H
@@ -20,11 +20,8 @@ struct Codec<std::map<KeyT, ValueT>>
    static 
    void encode(DBusMessageIter& iter, const std::map<KeyT, ValueT>& m)
    {
-      std::ostringstream buf;
-      Codec<std::pair<KeyT, ValueT>>::make_type_signature(buf);
-
       DBusMessageIter _iter;
-      dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, buf.str().c_str(), &_iter);
+      dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, detail::type_signature<std::pair<KeyT, ValueT>>(), &_iter);
 
       for (auto& e : m) {
          Codec<std::pair<KeyT, ValueT>>::encode(_iter, e);
@@ -34,20 +31,53 @@ struct Codec<std::map<KeyT, ValueT>>
    }
    
    
+   template<bool B = detail::has_wire_encoding<KeyT, ValueT>::value, typename = std::enable_if_t<B>>
+   static
+   void encode(detail::WireWriter& w, const std::map<KeyT, ValueT>& m)
+   {
+      auto arr = w.open_array(8);
+
+      for (auto& e : m) {
+         Codec<std::pair<KeyT, ValueT>>::encode(w, e);
+      }
+
+      w.close_array(arr);
+   }
+   
+   
    static 
    void decode(DBusMessageIter& iter, std::map<KeyT, ValueT>& m)
    {
       m.clear();
       
       DBusMessageIter _iter;
-      simppl_dbus_message_iter_recurse(&iter, &_iter, DBUS_TYPE_ARRAY);
+      detail::iter_recurse(&iter, &_iter, DBUS_TYPE_ARRAY);
 
       while(dbus_message_iter_get_arg_type(&_iter) != 0)
       {
-         std::pair<KeyT, ValueT> p;
-         Codec<decltype(p)>::decode(_iter, p);
-
-         m.insert(p);
+         DBusMessageIter item_iterator;
+         detail::iter_recurse(&_iter, &item_iterator, DBUS_TYPE_DICT_ENTRY);
+
+         KeyT key;
+         Codec<KeyT>::decode(item_iterator, key);
+
+         // the entries usually arrive sorted, so hint the insertion at the end
+         std::size_t size = m.size();
+         auto pos = m.try_emplace(m.end(), std::move(key));
+
+         if (m.size() != size)
+         {
+            Codec<ValueT>::decode(item_iterator, pos->second);
+         }
+         else
+         {
+            // duplicate key, the first one wins
+            ValueT value;
+            Codec<ValueT>::decode(item_iterator, value);
+         }
+
+         // advance to next element
+         dbus_message_iter_next(&_iter);
       }
 
       // advance to next element
@@ -60,6 +90,14 @@ struct Codec<std::map<KeyT, ValueT>>
    {
       return Codec<std::pair<typename std::decay<KeyT>::type, ValueT>>::make_type_signature(os << DBUS_TYPE_ARRAY_AS_STRING);
    }
+
+
+   template<bool B = detail::has_signature<Codec<std::pair<KeyT, ValueT>>>::value, typename = std::enable_if_t<B>>
+   static constexpr
+   auto signature()
+   {
+      return detail::make_fixed_string(DBUS_TYPE_ARRAY_AS_STRING) + Codec<std::pair<KeyT, ValueT>>::signature();
+   }
 };
 
    
@@ -0,0 +1,110 @@
+#ifndef SIMPPL_OBJECTMANAGERCLIENT_H
+#define SIMPPL_OBJECTMANAGERCLIENT_H
+
+
+#include <functional>
+#include <string>
+
+#include "simppl/stub.h"
+#include "simppl/pendingcall.h"
+#include "simppl/api/objectmanager.h"
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+/**
+ * Client side mirror of the objects of an org.freedesktop.DBus.ObjectManager.
+ * The mirror is filled by a single GetManagedObjects call as soon as the
+ * service is connected and kept up to date by the InterfacesAdded,
+ * InterfacesRemoved and PropertiesChanged signals, so all queries are
+ * answered locally. Invalidated properties are dropped from the mirror.
+ * PropertiesChanged signals are only accepted from the unique name owning
+ * the service's busname, other services may export the same paths.
+ *
+ * The mirror is only modified on the dispatcher's thread and must only be
+ * queried there, e.g. from within the callbacks.
+ */
+struct ObjectManagerClient
+{
+   friend struct Dispatcher;
+
+   typedef org::freedesktop::DBus::managed_objects_t objects_type;   ///< path -> interface -> property -> value
+   typedef objects_type::mapped_type interfaces_type;
+   typedef interfaces_type::mapped_type properties_type;
+
+   ObjectManagerClient(const ObjectManagerClient&) = delete;
+   ObjectManagerClient& operator=(const ObjectManagerClient&) = delete;
+
+   /**
+    * @param busname the service implementing the object manager.
+    * @param objectpath the path of the object manager, all managed objects
+    *        are expected below this path.
+    */
+   ObjectManagerClient(Dispatcher& disp, const char* busname, const char* objectpath);
+
+   ~ObjectManagerClient();
+
+   /// the mirror reflects the service's objects
+   inline
+   bool is_synced() const
+   {
+      return synced_;
+   }
+
+   inline
+   const objects_type& objects() const
+   {
+      return objects_;
+   }
+
+   /// @return the interfaces of the object or nullptr if unknown
+   const interfaces_type* find(const ObjectPath& path) const;
+
+   /// @return the properties of an interface of the object or nullptr if unknown
+   const properties_type* find(const ObjectPath& path, const std::string& iface) const;
+
+   /// @return the value of a property or nullptr if unknown
+   const Any* find(const ObjectPath& path, const std::string& iface, const std::string& property) const;
+
+   /// the mirror was filled after the service connected, it is cleared on disconnect
+   std::function<void(ConnectionState)> synced;
+
+   /// interfaces were added to an object, possibly a new one
+   std::function<void(const ObjectPath&)> added;
+
+   /// interfaces were removed from an object, it is gone if it has none left
+   std::function<void(const ObjectPath&)> removed;
+
+   /// properties of an interface of the object changed or were invalidated
+   std::function<void(const ObjectPath&, const std::string&)> changed;
+
+private:
+
+   void connection_state_changed(ConnectionState state);
+
+   /// called by the dispatcher for each PropertiesChanged signal
+   bool try_handle_properties_changed(DBusMessage& msg);
+
+   static
+   void owner_notify(DBusPendingCall* pc, void* data);
+
+   Stub<org::freedesktop::DBus::ObjectManager> stub_;
+
+   objects_type objects_;
+   std::string match_;   ///< PropertiesChanged of all objects below the manager
+
+   std::string owner_;      ///< unique name of the service, empty until known
+   PendingCall owner_call_;   ///< GetNameOwner request
+   bool synced_;
+};
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+#endif   // SIMPPL_OBJECTMANAGERCLIENT_H
@@ -1,7 +1,10 @@
 #ifndef __SIMPPL_DBUS_OBJECTMANAGERMIXIN_H__
 #define __SIMPPL_DBUS_OBJECTMANAGERMIXIN_H__
 
-#include <set>
+#include <map>
+#include <memory>
+#include <string>
+#include <typeinfo>
 
 #include "simppl/skeletonbase.h"
 
@@ -23,33 +26,127 @@ struct ObjectManagerMixin : public SkeletonBase
 {
 public:
 
-    ObjectManagerMixin(size_t size)
-     : SkeletonBase(size)
+    ObjectManagerMixin(size_t size, const char* key)
+     : SkeletonBase(size, key)
+     , flush_posted_(false)
     {
         // NOOP
     }
 
+    /// sends the signals of a still pending batch, see add_managed_objects()
+    ~ObjectManagerMixin();
+
     void add_managed_object(SkeletonBase* obj);
     void remove_managed_object(SkeletonBase* obj);
 
+    /**
+     * Add a range of objects. Other than add_managed_object() the
+     * InterfacesAdded signals are deferred to the next iteration of the
+     * dispatcher's eventloop, where all signals of the batch are sent at
+     * once. Objects added and removed again in the meantime are not
+     * announced at all. Must be called on the dispatcher's thread.
+     *
+     * @param begin, end a range of SkeletonBase* or SkeletonBase&.
+     */
+    template<typename IteratorT>
+    void add_managed_objects(IteratorT begin, IteratorT end)
+    {
+        for (; begin != end; ++begin)
+            add_deferred(to_pointer(*begin));
+
+        post_flush();
+    }
+
+    /// Remove a range of objects, see add_managed_objects().
+    template<typename IteratorT>
+    void remove_managed_objects(IteratorT begin, IteratorT end)
+    {
+        for (; begin != end; ++begin)
+            remove_deferred(to_pointer(*begin));
+
+        post_flush();
+    }
+
 private:
 
-    void serialize_object(DBusMessageIter& iter, const simppl::dbus::SkeletonBase& obj);
+    /// a deferred change of a managed object, see add_managed_objects()
+    struct Change
+    {
+        const detail::InterfaceTable* removed_ = nullptr;   ///< interfaces to announce as removed
+        bool added_ = false;
+    };
+
+    static inline
+    SkeletonBase* to_pointer(SkeletonBase* obj)
+    {
+        return obj;
+    }
+
+    static inline
+    SkeletonBase* to_pointer(SkeletonBase& obj)
+    {
+        return &obj;
+    }
+
+    template<typename T>
+    static inline
+    SkeletonBase* to_pointer(const std::unique_ptr<T>& obj)
+    {
+        return obj.get();
+    }
+
+    void add_deferred(SkeletonBase* obj);
+    void remove_deferred(SkeletonBase* obj);
+
+    void post_flush();
+    void flush();
+
+    void send_interfaces_added(const std::string& path);
+    void send_interfaces_removed(const char* path, const detail::InterfaceTable& table);
+
+    /**
+     * A managed object and its serialized entry of the GetManagedObjects
+     * reply, see detail::wire_body(). The entry is rebuilt after the
+     * object's properties changed or if it has uncached properties.
+     */
+    struct ManagedObject
+    {
+        SkeletonBase* obj_;
+
+        std::string fragment_;
+        unsigned int generation_;   ///< SkeletonBase::properties_generation() of the fragment
+        bool cached_;
+    };
+
+    /// @return true if all properties may be cached
+    bool serialize_object(DBusMessageIter& iter, const simppl::dbus::SkeletonBase& obj);
+
+    const std::string& fragment(ManagedObject& entry);
 
     DBusHandlerResult handle_objectmanager_request(DBusMessage* msg);
 
-    std::set<SkeletonBase*> objects_;
+    /// reply with all objects from first up to end, at most max_count of them
+    DBusHandlerResult send_managed_objects(DBusMessage* msg, std::map<std::string, ManagedObject>::iterator first, std::size_t max_count);
+
+    std::map<std::string, ManagedObject> objects_;   ///< by objectpath
+
+    std::map<std::string, Change> changes_;   ///< not yet signalled, by objectpath
+    bool flush_posted_;
+
+    /// the posted flush only holds a weak reference, so it may outlive this object
+    std::shared_ptr<ObjectManagerMixin*> self_;
 };
 
 
 namespace detail
 {
 
-template<size_t N>
+/// @param KeyT see SizedSkeletonBase
+template<size_t N, typename KeyT>
 struct SizedObjectManagerMixin : public simppl::dbus::ObjectManagerMixin
 {
     SizedObjectManagerMixin()
-     : ObjectManagerMixin(N)
+     : ObjectManagerMixin(N, typeid(KeyT).name())
     {
         // NOOP
     }
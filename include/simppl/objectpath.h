@@ -79,11 +79,23 @@ struct ObjectPathCodec
    static
    void encode(DBusMessageIter& iter, const ObjectPath& p);
 
+   static inline
+   void encode(detail::WireWriter& w, const ObjectPath& p)
+   {
+      w.write_string(p.path.c_str(), p.path.size());
+   }
+
    static
    void decode(DBusMessageIter& iter, ObjectPath& p);
 
    static
    std::ostream& make_type_signature(std::ostream& os);
+
+   static constexpr
+   auto signature()
+   {
+      return detail::make_fixed_string(DBUS_TYPE_OBJECT_PATH_AS_STRING);
+   }
 };
 
 
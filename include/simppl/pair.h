@@ -30,11 +30,22 @@ struct Codec<std::pair<KeyT, ValueT>>
    }
    
    
+   template<bool B = detail::has_wire_encoding<KeyT, ValueT>::value, typename = std::enable_if_t<B>>
+   static
+   void encode(detail::WireWriter& w, const std::pair<KeyT, ValueT>& p)
+   {
+      w.align(8);
+
+      Codec<KeyT>::encode(w, p.first);
+      Codec<ValueT>::encode(w, p.second);
+   }
+   
+   
    static 
    void decode(DBusMessageIter& iter, std::pair<KeyT, ValueT>& p)
    {
       DBusMessageIter item_iterator;
-      simppl_dbus_message_iter_recurse(&iter, &item_iterator, DBUS_TYPE_DICT_ENTRY);
+      detail::iter_recurse(&iter, &item_iterator, DBUS_TYPE_DICT_ENTRY);
 
       Codec<KeyT>::decode(item_iterator, p.first);
       Codec<ValueT>::decode(item_iterator, p.second);
@@ -54,6 +65,17 @@ struct Codec<std::pair<KeyT, ValueT>>
       
       return os << DBUS_DICT_ENTRY_END_CHAR_AS_STRING;
    }
+
+
+   template<bool B = detail::has_signature<Codec<KeyT>, Codec<ValueT>>::value, typename = std::enable_if_t<B>>
+   static constexpr
+   auto signature()
+   {
+      return detail::make_fixed_string(DBUS_DICT_ENTRY_BEGIN_CHAR_AS_STRING)
+         + Codec<KeyT>::signature()
+         + Codec<ValueT>::signature()
+         + detail::make_fixed_string(DBUS_DICT_ENTRY_END_CHAR_AS_STRING);
+   }
 };
 
    
@@ -21,6 +21,8 @@ struct PendingCall
 
     PendingCall(const PendingCall& rhs);
     PendingCall& operator=(const PendingCall& rhs);
+
+    ~PendingCall();
 	
     /** request serial */
     uint32_t serial() const;
@@ -35,7 +37,7 @@ struct PendingCall
 private:
 
     uint32_t serial_;
-    pending_call_ptr_t pending_;
+    DBusPendingCall* pending_;   ///< owns a reference, DBusPendingCall is refcounted itself
 };
 
 
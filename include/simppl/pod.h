@@ -32,6 +32,17 @@ template<> struct typecode_switch<int64_t>            { enum { value = DBUS_TYPE
 template<> struct typecode_switch<double>             { enum { value = DBUS_TYPE_DOUBLE  }; };
 
 
+/**
+ * Element types of arrays which are transferred as D-Bus fixed array, i.e.
+ * as one block of memory instead of element by element.
+ */
+template<typename T>
+struct is_fixed_array_element
+{
+   enum { value = isPod<T>::value && !std::is_same<T, float>::value };
+};
+
+
 template<typename T, bool>
 struct EnumTypeCodeHelper
 {
@@ -63,10 +74,22 @@ struct CodecImpl<T, Pod>
    }
    
    
+   static inline
+   void encode(detail::WireWriter& w, const T& t)
+   {
+      if constexpr(std::is_enum<T>::value)
+      {
+         w.write<int32_t>(static_cast<int32_t>(t));
+      }
+      else
+         w.write<T>(t);
+   }
+   
+   
    static inline
    void decode(DBusMessageIter& iter, T& t)
    {
-      simppl_dbus_message_iter_get_basic(&iter, &t, dbus_type_code);
+      detail::iter_get_basic(&iter, &t, dbus_type_code);
    }
    
    
@@ -75,9 +98,57 @@ struct CodecImpl<T, Pod>
    {
       return os << (char)dbus_type_code;
    }
+
+
+   static constexpr
+   auto signature()
+   {
+      return detail::make_fixed_string((char)dbus_type_code);
+   }
 };
 
 
+namespace detail
+{
+
+/**
+ * Point to the fixed-size elements of the array the iterator points to and
+ * advance the iterator.
+ */
+template<typename T>
+std::size_t get_fixed_array(DBusMessageIter& iter, const T*& data)
+{
+   DBusMessageIter _iter;
+   detail::iter_recurse(&iter, &_iter, DBUS_TYPE_ARRAY);
+
+   if (dbus_message_iter_get_element_type(&iter) != typecode_switch<T>::value)
+      throw DecoderError();
+
+   int len = 0;
+   data = nullptr;
+   dbus_message_iter_get_fixed_array(&_iter, &data, &len);
+
+   // advance to next element
+   dbus_message_iter_next(&iter);
+
+   return len;
+}
+
+
+template<typename T>
+void append_fixed_array(DBusMessageIter& iter, const T* data, std::size_t size)
+{
+   DBusMessageIter _iter;
+   dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, signature_v<T>.c_str(), &_iter);
+
+   dbus_message_iter_append_fixed_array(&_iter, typecode_switch<T>::value, &data, size);
+
+   dbus_message_iter_close_container(&iter, &_iter);
+}
+
+}   // namespace detail
+
+
 }   // namespace dbus
 
 }   // namespace simppl
@@ -4,10 +4,90 @@
 
 #include <cstdint>
 #include <sstream>
+#include <string>
+#include <type_traits>
 
 #include <dbus/dbus.h>
 
 #include "simppl/typelist.h"
+#include "simppl/detail/fixedstring.h"
+#include "simppl/detail/wirewriter.h"
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+class DecoderError : public std::exception
+{
+};
+
+
+namespace detail
+{
+
+/**
+ * Set while decoding a message whose signature was already validated as
+ * a whole, the type checks of the single elements are skipped then.
+ */
+extern __thread bool validated_decoding;
+
+
+/// scope of decoding a validated message
+struct ValidatedDecoding
+{
+   explicit inline
+   ValidatedDecoding(bool validated = true)
+    : previous_(validated_decoding)
+   {
+      validated_decoding = validated;
+   }
+
+   inline
+   ~ValidatedDecoding()
+   {
+      validated_decoding = previous_;
+   }
+
+   ValidatedDecoding(const ValidatedDecoding&) = delete;
+   ValidatedDecoding& operator=(const ValidatedDecoding&) = delete;
+
+   bool previous_;
+};
+
+
+/**
+ * Inline variants of simppl_dbus_message_iter_recurse() and
+ * simppl_dbus_message_iter_get_basic() used by the codecs, the type
+ * check is skipped within a ValidatedDecoding scope.
+ */
+inline
+void iter_recurse(DBusMessageIter* iter, DBusMessageIter* nested, int expected_type)
+{
+   if (!validated_decoding && dbus_message_iter_get_arg_type(iter) != expected_type)
+      throw DecoderError();
+
+   dbus_message_iter_recurse(iter, nested);
+}
+
+
+inline
+void iter_get_basic(DBusMessageIter* iter, void* p, int expected_type)
+{
+   if (!validated_decoding && dbus_message_iter_get_arg_type(iter) != expected_type)
+      throw DecoderError();
+
+   dbus_message_iter_get_basic(iter, p);
+   dbus_message_iter_next(iter);
+}
+
+}   // namespace detail
+
+}   // namespace dbus
+
+}   // namespace simppl
 
 
 /// throwing exception if expected_type is not met.
@@ -15,7 +95,7 @@ void simppl_dbus_message_iter_recurse(DBusMessageIter* iter, DBusMessageIter* ne
 
 /// throwing exception if expected_type is not met; advancing iterator
 void simppl_dbus_message_iter_get_basic(DBusMessageIter* iter, void* p, int expected_type);
-      
+
 
 namespace simppl
 {
@@ -62,6 +142,109 @@ struct Struct;
 template<typename T, typename DeducerT>
 struct CodecImpl;
 
+template<typename T>
+struct Codec;
+
+
+namespace detail
+{
+
+template<typename CodecT, typename = void>
+struct has_signature_helper : std::false_type {};
+
+template<typename CodecT>
+struct has_signature_helper<CodecT, std::void_t<decltype(CodecT::signature())>> : std::true_type {};
+
+
+/**
+ * True if all given codecs provide their type signature as constant
+ * expression via a static signature() function. User-defined codecs may
+ * only provide the make_type_signature stream interface.
+ */
+template<typename... CodecT>
+struct has_signature : std::conjunction<has_signature_helper<CodecT>...> {};
+
+
+template<typename T>
+inline constexpr auto signature_v = Codec<T>::signature();
+
+
+/**
+ * The type signature of T as C string for usage on the encoding and decoding
+ * paths. Codecs without a compile-time signature are asked once via their
+ * stream interface.
+ */
+template<typename T>
+inline
+const char* type_signature()
+{
+   if constexpr(has_signature<Codec<T>>::value)
+   {
+      return signature_v<T>.c_str();
+   }
+   else
+   {
+      static const std::string sig = [](){
+         std::ostringstream os;
+         Codec<T>::make_type_signature(os);
+         return os.str();
+      }();
+
+      return sig.c_str();
+   }
+}
+
+template<typename T, typename = void>
+struct has_wire_encoding_helper : std::false_type {};
+
+template<typename T>
+struct has_wire_encoding_helper<T, std::void_t<decltype(Codec<T>::encode(std::declval<WireWriter&>(), std::declval<const T&>()))>> : std::true_type {};
+
+
+/**
+ * True if all given types have a compile-time signature and their codecs
+ * may write them directly in wire format via an encode(WireWriter&, const T&)
+ * overload. Otherwise the types must be encoded by the message iterators.
+ */
+template<typename... T>
+struct has_wire_encoding : std::conjunction<has_signature<Codec<T>>..., has_wire_encoding_helper<T>...> {};
+
+
+/**
+ * True if the memory layout of T equals its wire format without any padding,
+ * so arrays of T may be written as one block of memory. See struct.h.
+ */
+template<typename T, typename = void>
+struct is_wire_layout_compatible : std::false_type {};
+
+
+/**
+ * The concatenated type signatures of all arguments, i.e. the signature of
+ * a message carrying them.
+ */
+template<typename... T>
+inline
+const char* args_signature()
+{
+   if constexpr(has_signature<Codec<T>...>::value)
+   {
+      static constexpr auto sig = (make_fixed_string("") + ... + Codec<T>::signature());
+      return sig.c_str();
+   }
+   else
+   {
+      static const std::string sig = [](){
+         std::ostringstream os;
+         (Codec<T>::make_type_signature(os), ...);
+         return os.str();
+      }();
+
+      return sig.c_str();
+   }
+}
+
+}   // namespace detail
+
 
 // type switch
 template<typename T>
@@ -79,6 +262,14 @@ struct Codec
    }
    
    
+   template<typename ImplT = impl_type>
+   static inline
+   auto encode(detail::WireWriter& w, const T& t) -> decltype(ImplT::encode(w, t))
+   {
+      impl_type::encode(w, t);
+   }
+
+
    static inline
    void decode(DBusMessageIter& s, T& t)
    {
@@ -91,6 +282,14 @@ struct Codec
    {
       return impl_type::make_type_signature(os);
    }
+
+
+   template<typename ImplT = impl_type>
+   static constexpr
+   auto signature() -> decltype(ImplT::signature())
+   {
+      return ImplT::signature();
+   }
 };
 
 
@@ -110,6 +309,22 @@ void encode(DBusMessageIter& iter, const T1& t1, const T&... t)
 }
 
 
+inline
+void encode(detail::WireWriter&)
+{
+   // NOOP
+}
+
+
+template<typename T1, typename... T>
+inline
+void encode(detail::WireWriter& w, const T1& t1, const T&... t)
+{
+   Codec<typename simppl::remove_all_const<T1>::type>::encode(w, t1);
+   encode(w, t...);
+}
+
+
 inline
 void decode(DBusMessageIter&)
 {
@@ -126,11 +341,6 @@ void decode(DBusMessageIter& iter, T1& t1, T&... t)
 }
 
 
-class DecoderError : public std::exception
-{
-};
-
-
 }   // namespace dbus
 
 }   // namespace simppl
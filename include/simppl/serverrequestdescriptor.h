@@ -17,6 +17,7 @@ namespace dbus
    
 // forward decl
 struct ServerMethodBase;
+struct SkeletonBase;
 
 
 struct ServerRequestDescriptor
@@ -38,6 +39,9 @@ struct ServerRequestDescriptor
    
    ServerMethodBase* requestor_;
    DBusMessage* msg_;
+
+   SkeletonBase* skeleton_;   ///< only set if the response is ordered per sender
+   uint32_t sequence_;        ///< position within the sender's response sequence
 };
 
 }   // namespace dbus
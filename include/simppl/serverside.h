@@ -2,6 +2,10 @@
 #define SIMPPL_SERVERSIDE_H
 
 
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
 #include <dbus/dbus.h>
 
 #include "simppl/calltraits.h"
@@ -32,11 +36,35 @@ namespace simppl
 namespace dbus
 {
 
+// forward decl
+template<typename T>
+struct Task;
+
+
 namespace detail
 {
     // forward decl
     template<bool Notifying, int Flags>
     struct Assigner;
+
+    /// see coroutine.h
+    template<typename MethodT, typename TaskT>
+    struct TaskResponder;
+
+    template<typename T>
+    struct is_task : std::false_type {};
+
+    template<typename T>
+    struct is_task<Task<T>> : std::true_type {};
+
+    template<typename FuncT, typename CallbackT>
+    struct server_callback_result;
+
+    template<typename FuncT, typename... T>
+    struct server_callback_result<FuncT, std::function<void(T...)>>
+    {
+        typedef std::invoke_result_t<const FuncT&, T...> type;
+    };
 }
 
 
@@ -56,13 +84,23 @@ struct ServerMethodBase
        return throw_(this, msg, err);
    }
 
+   /**
+    * Run the handler on the given pool, overrides the pool set on the
+    * skeleton. nullptr reverts to the skeleton's setting.
+    */
+   void set_executor(ThreadPool* pool)
+   {
+       executor_ = pool;
+   }
+
 
 #if SIMPPL_HAVE_INTROSPECTION
    virtual void introspect(std::ostream& os) const = 0;
 #endif
 
-   ServerMethodBase* next_;
    const char* name_;
+   ThreadPool* executor_;
+   SkeletonBase* parent_;
 
 protected:
 
@@ -80,11 +118,12 @@ protected:
 
 struct ServerSignalBase
 {
+   friend struct SkeletonBase;
+
    ServerSignalBase(const char* name, SkeletonBase* iface, int iface_id);
 
 #if SIMPPL_HAVE_INTROSPECTION
    virtual void introspect(std::ostream& os) const = 0;
-   ServerSignalBase* next_;   // list hook
 #endif
 
 protected:
@@ -108,8 +147,8 @@ struct ServerSignal : ServerSignalBase
 
    void notify(typename CallTraits<T>::param_type... args)
    {
-       parent_->send_signal(this->name_, this->iface_id_, [&](DBusMessageIter& iter){
-            encode(iter, args...);
+       parent_->send_signal(this->name_, this->iface_id_, [&](message_ptr_t& msg){
+            detail::encode_message(msg, args...);
        });
    }
 
@@ -168,6 +207,20 @@ struct ServerMethod : ServerMethodBase
       return __impl(bool_constant<(sizeof...(t) > 0)>(), t...);
    }
 
+   /**
+    * Set the request handler. If the handler is a coroutine returning a
+    * Task (see coroutine.h), the response is sent as soon as the coroutine
+    * co_returns the out values. Such handlers must take their arguments by
+    * value.
+    */
+   template<typename FuncT>
+   void set_callback(const FuncT& f)
+   {
+      typedef typename detail::server_callback_result<FuncT, callback_type>::type result_type;
+
+      __set_callback<result_type>(f, detail::is_task<result_type>());
+   }
+
 #if SIMPPL_HAVE_INTROSPECTION
    void introspect(std::ostream& os) const override
    {
@@ -182,13 +235,31 @@ struct ServerMethod : ServerMethodBase
 
 private:
 
+   template<typename ResultT, typename FuncT>
+   void __set_callback(const FuncT& f, std::false_type)
+   {
+      f_ = f;
+   }
+
+   template<typename ResultT, typename FuncT>
+   void __set_callback(const FuncT& f, std::true_type)
+   {
+      f_ = detail::TaskResponder<ServerMethod, ResultT>::wrap(*this, f);
+   }
+
    static
    void __eval(ServerMethodBase* obj, DBusMessage* msg)
    {
+       typedef typename detail::GetCaller<args_type>::type caller_type;
+
+       // check the signature once, then decode without checking each element
+       if (strcmp(dbus_message_get_signature(msg), caller_type::signature()))
+           throw DecoderError();
+
        DBusMessageIter iter;
        dbus_message_iter_init(msg, &iter);
 
-       detail::GetCaller<args_type>::type::template eval(iter, ((ServerMethod*)obj)->f_);
+       caller_type::template eval(iter, ((ServerMethod*)obj)->f_, true);
    }
 
 
@@ -203,15 +274,15 @@ private:
    template<typename... T>
    detail::ServerResponseHolder __impl(std::true_type, const T&... t)
    {
-      return detail::ServerResponseHolder([&](DBusMessageIter& s){
-         serializer_type::eval(s, t...);
+      return detail::ServerResponseHolder([&](message_ptr_t& msg){
+         serializer_type::eval(msg, t...);
       });
    }
 
    template<typename... T>
    detail::ServerResponseHolder __impl(std::false_type, const T&... t)
    {
-      return detail::ServerResponseHolder([](DBusMessageIter&){ /*NOOP*/ });
+      return detail::ServerResponseHolder();
    }
 };
 
@@ -240,15 +311,18 @@ struct ServerPropertyBase
    virtual void introspect(std::ostream& os) const = 0;
 #endif
 
-   ServerPropertyBase* next_;   ///< list hook
    const char* name_;
    int iface_id_;
    SkeletonBase* parent_;
+   bool cacheable_;   ///< value may be served from the GetAll cache
 
 protected:
 
    ~ServerPropertyBase() = default;
 
+   /// the value changed, drops the GetAll cache of the interface
+   void changed();
+
    eval_type eval_;
    eval_set_type eval_set_;
 };
@@ -287,7 +361,8 @@ struct BaseProperty : ServerPropertyBase
     */
    void notify(const DataT& data)
    {
-      this->parent_->send_property_change(this->name_, this->iface_id_, [this, data](DBusMessageIter& iter){
+      this->changed();
+      this->parent_->send_property_change(this->name_, this->iface_id_, [&data](DBusMessageIter& iter){
          detail::PropertyCodec<DataT>::encode(iter, data);
       });
    }
@@ -298,13 +373,30 @@ struct BaseProperty : ServerPropertyBase
     */
    void invalidate()
    {
+      this->changed();
       this->parent_->send_property_invalidate(this->name_, this->iface_id_);
    }
 
-   /// set callback for each read
-   void on_read(cb_type cb)
+   /**
+    * Set callback for each read. The callback is also called for each
+    * GetAll request unless caching is enabled. Then the value is read
+    * once and served from the cache until notify(), invalidate() or
+    * invalidate_cache() is called.
+    */
+   void on_read(cb_type cb, bool cached = false)
    {
        t_ = cb;
+       this->cacheable_ = cached;
+       this->changed();
+   }
+
+   /**
+    * Drop the cached GetAll reply without sending a change signal, e.g.
+    * if the value returned by a cached on_read callback changed.
+    */
+   void invalidate_cache()
+   {
+       this->changed();
    }
 
 protected:
@@ -361,6 +453,7 @@ namespace detail
         void eval(BaseProperty<DataT>& p, const DataT& d)
         {
             p.t_ = d;
+            p.changed();
         }
     };
 
@@ -398,6 +491,7 @@ struct ServerProperty : BaseProperty<DataT>, std::conditional<Flags & ReadWrite,
       if (this->t_.index() == std::variant_npos)
       {
          this->t_ = data;
+         this->changed();
       }
       else
          detail::Assigner<Flags & Notifying ? true : false, Flags>::eval(*this, data);
@@ -441,7 +535,7 @@ template<typename FunctorT, typename... T>
 inline
 void operator>>(simppl::dbus::ServerMethod<T...>& r, const FunctorT& f)
 {
-    r.f_ = f;
+    r.set_callback(f);
 }
 
 
@@ -0,0 +1,108 @@
+#ifndef SIMPPL_SHARDEDDISPATCHER_H
+#define SIMPPL_SHARDEDDISPATCHER_H
+
+
+#include <atomic>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "simppl/dispatcher.h"
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+/**
+ * A set of dispatchers, each with its own DBusConnection and each running
+ * its self-hosted eventloop on its own thread. Since libdbus serializes all
+ * I/O on a connection, this allows to spread the load of a service over
+ * multiple cores.
+ *
+ * Skeletons and stubs are assigned to a shard by passing the shard's
+ * dispatcher to their constructor, either chosen explicitly via @c shard()
+ * or via @c shard_for(). Objects on different shards must not call each
+ * other directly, use Dispatcher::post() instead.
+ */
+struct ShardedDispatcher
+{
+   ShardedDispatcher(const ShardedDispatcher&) = delete;
+   ShardedDispatcher& operator=(const ShardedDispatcher&) = delete;
+
+   /**
+    * @param shards number of connections, 0 means one per core.
+    * @param busname the bus to connect to, see Dispatcher::Dispatcher().
+    */
+   explicit
+   ShardedDispatcher(std::size_t shards = 0, const char* busname = nullptr);
+
+   ~ShardedDispatcher();
+
+   inline
+   std::size_t size() const
+   {
+      return shards_.size();
+   }
+
+   inline
+   Dispatcher& shard(std::size_t index)
+   {
+      return *shards_.at(index);
+   }
+
+   /**
+    * Shard for a skeleton. A busname is owned by exactly one connection, so
+    * all skeletons requesting the same busname end up on the same shard.
+    * The first skeleton of a busname is placed by its objectpath's hash.
+    */
+   Dispatcher& shard_for(const std::string& busname, const std::string& objectpath);
+
+   /**
+    * Shard for a stub, placed by the objectpath's hash.
+    */
+   Dispatcher& shard_for(const std::string& objectpath);
+
+   /**
+    * Run all shards, each on its own thread. Blocks until all shards are
+    * stopped. An exception thrown on any shard stops all shards and the
+    * first one is propagated out of run().
+    */
+   int run();
+
+   /**
+    * Stop all shards. May be called from any thread. Stopping a single
+    * shard's dispatcher has no effect on the sharded eventloop.
+    */
+   void stop();
+
+   /**
+    * Counters of all shards combined.
+    */
+   Dispatcher::Statistics statistics() const;
+
+private:
+
+   std::size_t index_for(const std::string& objectpath) const;
+   void run_shard(Dispatcher& shard);
+
+   std::atomic_bool running_;
+   std::exception_ptr error_;   ///< first exception thrown on a shard
+   std::vector<std::unique_ptr<Dispatcher>> shards_;
+
+   std::mutex mutex_;
+   std::map<std::string, std::size_t> busnames_;   ///< busname to shard index
+};
+
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+#endif   // SIMPPL_SHARDEDDISPATCHER_H
@@ -53,6 +53,13 @@ struct Skeleton : public detail::Interposer<sizeof...(Is)-1,
         dispatcher_add_skeleton(disp, *this);
     }
 
+    inline
+    ~Skeleton()
+    {
+        // the handlers are still alive here, but not in ~SkeletonBase
+        this->drain_executor();
+    }
+
 
 protected:
 
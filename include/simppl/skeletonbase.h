@@ -1,7 +1,9 @@
 #ifndef SIMPPL_SKELETONBASE_H
 #define SIMPPL_SKELETONBASE_H
 
+#include <memory>
 #include <string>
+#include <typeinfo>
 #include <vector>
 
 #include <dbus/dbus.h>
@@ -9,6 +11,8 @@
 #include "simppl/error.h"
 #include "simppl/serverrequestdescriptor.h"
 
+#include "simppl/detail/function_ref.h"
+#include "simppl/detail/interfacetable.h"
 #include "simppl/detail/serverresponseholder.h"
 
 
@@ -23,6 +27,7 @@ struct Dispatcher;
 struct ServerMethodBase;
 struct ServerPropertyBase;
 struct ServerSignalBase;
+struct ThreadPool;
 
 
 struct SkeletonBase
@@ -37,11 +42,19 @@ struct SkeletonBase
     friend struct ServerPropertyBase;
     friend struct ServerSignalBase;
     friend struct ObjectManagerMixin;
+    friend struct ServerRequestDescriptor;
 
     static DBusHandlerResult method_handler(DBusConnection *connection, DBusMessage *message, void *user_data);
 
     SkeletonBase(std::size_t iface_count);
 
+    /**
+     * Attach the interface table of the given skeleton type key right away
+     * if another object of that type already built it. The members do not
+     * need to register themselves then, see init_table().
+     */
+    SkeletonBase(std::size_t iface_count, const char* key);
+
     virtual ~SkeletonBase();
 
     Dispatcher& disp();
@@ -63,11 +76,34 @@ struct SkeletonBase
 
     const ServerRequestDescriptor& current_request() const;
 
+    /**
+     * Run the method handlers of this object on the given pool instead of
+     * the dispatcher thread. Responses are always sent from the dispatcher
+     * thread, so the self-hosted eventloop must be used. The pool must
+     * outlive the skeleton.
+     *
+     * Destroying the skeleton waits for its handlers currently running on
+     * a pool, queued ones are dropped without response. Handlers using
+     * members of a class derived from the skeleton therefore require
+     * calling drain_executor() first in the derived class' destructor.
+     *
+     * @param pool the pool to use or nullptr to handle requests inline.
+     * @param ordered send the responses to each sender in the order the
+     *        requests were received, even if the handlers finish out of order.
+     */
+    void set_executor(ThreadPool* pool, bool ordered = false);
+
+    /**
+     * Wait for the handlers of this object currently running on a thread
+     * pool. Handlers not yet started are not run anymore, so this is only
+     * meant for destruction. Must not be called from within a handler.
+     */
+    void drain_executor();
+
     inline
     const std::string& iface(size_type iface_id) const
     {
-        // `ifaces_[0]` has the highest ID (e.g. N-1).
-        return ifaces_[ifaces_.size() - iface_id - 1];
+        return table_->ifaces_[iface_id].name_;
     }
 
     inline
@@ -82,10 +118,10 @@ struct SkeletonBase
         return busname_.c_str();
     }
 
-    void send_property_change(const char* prop, int iface_id, std::function<void(DBusMessageIter&)>&& f);
+    void send_property_change(const char* prop, int iface_id, detail::function_ref<void(DBusMessageIter&)> f);
     void send_property_invalidate(const char* prop, int iface_id);
 
-    void send_signal(const char* signame, int iface_id, std::function<void(DBusMessageIter&)>&& f);
+    void send_signal(const char* signame, int iface_id, detail::function_ref<void(message_ptr_t&)> f);
 
 protected:
     static constexpr int invalid_iface_id = -1;
@@ -93,6 +129,17 @@ protected:
     void init(const char* mangled_iface_list, const char* role);
     void init(size_type iface_count, const char* mangled_iface_list, std::string busname, std::string objectpath);
     void init(std::string busname, std::string objectpath);
+    void init(size_type iface_count, const char* mangled_iface_list);
+
+    /**
+     * Attach the interface table shared by all skeletons of the given type
+     * key, the table is built from the members registered by this object if
+     * it is the first one.
+     *
+     * @param ifaces the interface names, the first has the highest id.
+     */
+    void init_table(const std::string& key, const std::vector<std::string>& ifaces);
+    void init_table(const std::string& key, detail::function_ref<std::vector<std::string>()> ifaces);
 
     DBusHandlerResult handle_request(DBusMessage* msg);
 #if SIMPPL_HAVE_INTROSPECTION
@@ -103,14 +150,36 @@ protected:
     DBusHandlerResult handle_property_set_request(DBusMessage* msg, ServerPropertyBase& property, DBusMessageIter& iter);
     DBusHandlerResult handle_interface_request(DBusMessage* msg, ServerMethodBase& method);
     DBusHandlerResult handle_error(DBusMessage* msg, const char* dbus_error);
+    void eval_request(ServerRequestDescriptor& req);
     DBusHandlerResult handle_property_getall_request(DBusMessage* msg, int iface_id);
 
     virtual DBusHandlerResult handle_objectmanager_request(DBusMessage* msg);
 
 #if SIMPPL_HAVE_INTROSPECTION
-    void introspect_interface(std::ostream& os, size_type index) const;
+    void introspect_interface(std::ostream& os, const detail::InterfaceTable& table, size_type index) const;
 #endif
     bool has_any_properties() const;
+
+    /// register a member for building the interface table, see init_table()
+    void add_member(ServerMethodBase* method, int iface_id);
+    void add_member(ServerPropertyBase* property, int iface_id);
+#if SIMPPL_HAVE_INTROSPECTION
+    void add_member(ServerSignalBase* signal, int iface_id);
+#endif
+
+    /// a property of the interface changed, see PropertyCache
+    void property_changed(int iface_id);
+
+    /// changes whenever any property of the object changes
+    unsigned int properties_generation() const;
+
+    /// the member at the given offset, see InterfaceTable
+    template<typename MemberT>
+    MemberT* member(std::ptrdiff_t offset) const
+    {
+        return (MemberT*)((char*)this + offset);
+    }
+
     ServerPropertyBase* find_property(int iface_id, const char* name) const;
     ServerMethodBase* find_method(int iface_id, const char* name) const;
     int find_interface(const char* name) const;
@@ -133,22 +202,43 @@ protected:
         return find_method(iface_id, name.c_str());
     }
 
+    /// the request currently handled by the calling thread
+    ServerRequestDescriptor& request();
+    const ServerRequestDescriptor& request() const;
+
+    /// send a message, from pool threads via the dispatcher thread
+    void send(message_ptr_t msg);
+
+    /// send the response to the request and clear it
+    void send_response(ServerRequestDescriptor& req, message_ptr_t msg);
+    void skip_response(ServerRequestDescriptor& req);
+
     /// return a session pointer and destruction function if adequate
     ///virtual std::tuple<void*,void(*)(void*)> clientAttached();
 
-    std::vector<std::string> ifaces_;
+    const detail::InterfaceTable* table_;
+
     std::string busname_;
     std::string objectpath_;
 
     Dispatcher* disp_;
     ServerRequestDescriptor current_request_;
 
-    // linked list heads
-    std::vector<ServerMethodBase*> method_heads_;
-    std::vector<ServerPropertyBase*> property_heads_;
+    struct ResponseSequencer;
+    struct PendingHandlers;
+
+    struct Executor;
+    std::unique_ptr<Executor> executor_;   ///< only set once a thread pool is used
+
+    struct PropertyCache;
+    std::unique_ptr<PropertyCache[]> property_cache_;   ///< per interface, only set with properties
+
+    struct TableBuilder;
+    std::unique_ptr<TableBuilder> builder_;   ///< only set until the interface table is built
 
 #if SIMPPL_HAVE_INTROSPECTION
-    std::vector<ServerSignalBase*> signal_heads_;
+    struct IntrospectionCache;
+    std::unique_ptr<IntrospectionCache> introspection_;   ///< only set once introspected
 #endif
 };
 
@@ -156,8 +246,17 @@ protected:
 namespace detail
 {
 
-template<std::size_t N>
+/**
+ * @param KeyT identifies the skeleton type for sharing the interface table,
+ *        see Skeleton::interface_list.
+ */
+template<std::size_t N, typename KeyT = void>
 struct SizedSkeletonBase : SkeletonBase {
+    SizedSkeletonBase() : SkeletonBase(N, typeid(KeyT).name()) {}
+};
+
+template<std::size_t N>
+struct SizedSkeletonBase<N, void> : SkeletonBase {
     SizedSkeletonBase() : SkeletonBase(N) {}
 };
 
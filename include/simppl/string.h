@@ -2,7 +2,9 @@
 #define SIMPPL_DBUS_STRING_H
 
 
+#include <cstring>
 #include <string>
+#include <string_view>
 
 #include "simppl/serialization.h"
 
@@ -27,9 +29,43 @@ struct StringCodec
    
    static 
    void decode(DBusMessageIter& s, char*& str);
+
+   static
+   void encode(DBusMessageIter& s, std::string_view str);
+
+   static inline
+   void encode(detail::WireWriter& w, const std::string& str)
+   {
+      w.write_string(str.c_str(), str.size());
+   }
+
+   static inline
+   void encode(detail::WireWriter& w, const char* str)
+   {
+      w.write_string(str, strlen(str));
+   }
+
+   static inline
+   void encode(detail::WireWriter& w, std::string_view str)
+   {
+      w.write_string(str.data(), str.size());
+   }
+
+   /**
+    * No copy of data: the view points into the received message and is
+    * therefore only valid as long as the message, i.e. within the callback.
+    */
+   static
+   void decode(DBusMessageIter& s, std::string_view& str);
    
    static
    std::ostream& make_type_signature(std::ostream& os);
+
+   static constexpr
+   auto signature()
+   {
+      return detail::make_fixed_string(DBUS_TYPE_STRING_AS_STRING);
+   }
 };
 
    
@@ -39,6 +75,9 @@ struct Codec<std::string> : public StringCodec {};
 template<>
 struct Codec<char*> : public StringCodec {};
 
+template<>
+struct Codec<std::string_view> : public StringCodec {};
+
    
 }   // namespace dbus
 
@@ -2,12 +2,17 @@
 #define SIMPPL_DBUS_STRUCT_H
 
 
+#include <utility>
+
 #include "simppl/serialization.h"
 
 #if SIMPPL_HAVE_BOOST_FUSION
 #   include <boost/fusion/adapted/struct/adapt_struct.hpp>
 #   include <boost/fusion/support/is_sequence.hpp>
 #   include <boost/fusion/algorithm.hpp>
+#   include <boost/fusion/sequence/intrinsic/at_c.hpp>
+#   include <boost/fusion/sequence/intrinsic/size.hpp>
+#   include <boost/fusion/sequence/intrinsic/value_at.hpp>
 #endif
 
 
@@ -28,6 +33,15 @@ struct SerializerTuple : T1
    }
 
 
+   template<typename U1 = T1, typename U2 = T2>
+   auto encode(detail::WireWriter& w) const
+      -> decltype(std::declval<const U1&>().encode(w), Codec<U2>::encode(w, std::declval<const U2&>()))
+   {
+      T1::encode(w);
+      Codec<T2>::encode(w, data_);
+   }
+
+
    void decode(DBusMessageIter& iter)
    {
       T1::decode(iter);
@@ -42,6 +56,14 @@ struct SerializerTuple : T1
       Codec<T2>::make_type_signature(os);
    }
 
+
+   template<bool B = detail::has_signature<T1, Codec<T2>>::value, typename = std::enable_if_t<B>>
+   static constexpr
+   auto signature()
+   {
+      return T1::signature() + Codec<T2>::signature();
+   }
+
    T2 data_;
 };
 
@@ -55,6 +77,13 @@ struct SerializerTuple<T, NilType>
    }
 
 
+   template<typename U = T>
+   auto encode(detail::WireWriter& w) const -> decltype(Codec<U>::encode(w, std::declval<const U&>()))
+   {
+      Codec<T>::encode(w, data_);
+   }
+
+
    void decode(DBusMessageIter& iter)
    {
       Codec<T>::decode(iter, data_);
@@ -67,6 +96,14 @@ struct SerializerTuple<T, NilType>
       Codec<T>::make_type_signature(os);
    }
 
+
+   template<bool B = detail::has_signature<Codec<T>>::value, typename = std::enable_if_t<B>>
+   static constexpr
+   auto signature()
+   {
+      return Codec<T>::signature();
+   }
+
    T data_;
 };
 
@@ -74,6 +111,44 @@ struct SerializerTuple<T, NilType>
 namespace detail
 {
 
+/**
+ * Wire layout of the members of a serializer_type: packed_ if all members
+ * are fixed-size and each is naturally aligned without any padding.
+ */
+template<typename S>
+struct serializer_layout;
+
+template<typename T>
+struct serializer_layout<SerializerTuple<T, NilType>>
+{
+   enum { packed_ = is_fixed_array_element<T>::value, size_ = sizeof(T) };
+};
+
+template<typename T1, typename T2>
+struct serializer_layout<SerializerTuple<T1, T2>>
+{
+   enum {
+      packed_ = serializer_layout<T1>::packed_ && is_fixed_array_element<T2>::value && serializer_layout<T1>::size_ % sizeof(T2) == 0,
+      size_ = serializer_layout<T1>::size_ + sizeof(T2)
+   };
+};
+
+
+/**
+ * Structs of packed fixed-size members without padding, also not at the end
+ * as each struct is 8-byte aligned on the wire, e.g. struct { int32_t;
+ * int32_t; double; }. As the members of the struct must match the
+ * serializer_type anyway, the sizes are sufficient to prove the layout.
+ */
+template<typename T>
+struct is_wire_layout_compatible<T, std::void_t<typename T::serializer_type>>
+ : std::integral_constant<bool, std::is_trivially_copyable<T>::value
+      && serializer_layout<typename T::serializer_type>::packed_
+      && serializer_layout<typename T::serializer_type>::size_ == sizeof(T)
+      && sizeof(T) % 8 == 0>
+{
+};
+
 
 #if SIMPPL_HAVE_BOOST_FUSION
 
@@ -147,6 +222,23 @@ struct StructSerializationHelper
    static
    void encode(DBusMessageIter& iter, const StructT& st);
 
+   template<typename S = s_type>
+   static inline
+   auto encode(WireWriter& w, const StructT& st) -> decltype(std::declval<const S&>().encode(w))
+   {
+      if constexpr(is_wire_layout_compatible<StructT>::value)
+      {
+         w.write_block(&st, sizeof(StructT), 8);
+      }
+      else
+      {
+         w.align(8);
+
+         const s_type& tuple = *(s_type*)&st;
+         tuple.encode(w);
+      }
+   }
+
    static
    void decode(DBusMessageIter& iter, const StructT& st);
 
@@ -156,6 +248,16 @@ struct StructSerializationHelper
       s_type::make_type_signature(os << DBUS_STRUCT_BEGIN_CHAR_AS_STRING);
       return os << DBUS_STRUCT_END_CHAR_AS_STRING;
    }
+
+
+   template<bool B = has_signature<s_type>::value, typename = std::enable_if_t<B>>
+   static constexpr
+   auto signature()
+   {
+      return make_fixed_string(DBUS_STRUCT_BEGIN_CHAR_AS_STRING)
+         + s_type::signature()
+         + make_fixed_string(DBUS_STRUCT_END_CHAR_AS_STRING);
+   }
 };
 
 
@@ -176,7 +278,7 @@ template<typename StructT, typename SelectorT>
 void StructSerializationHelper<StructT, SelectorT>::decode(DBusMessageIter& iter, const StructT& st)
 {
    DBusMessageIter _iter;
-   simppl_dbus_message_iter_recurse(&iter, &_iter, DBUS_TYPE_STRUCT);
+   detail::iter_recurse(&iter, &_iter, DBUS_TYPE_STRUCT);
 
    s_type& tuple = *(s_type*)&st;
    tuple.decode(_iter);
@@ -201,11 +303,28 @@ struct StructSerializationHelper<StructT, boost::mpl::true_>
       dbus_message_iter_close_container(&iter, &_iter);
    }
 
+   template<std::size_t... I, typename = std::enable_if_t<
+      has_wire_encoding<typename boost::fusion::result_of::value_at_c<StructT, I>::type...>::value>>
+   static inline
+   void encode_members(WireWriter& w, const StructT& st, std::index_sequence<I...>)
+   {
+      w.align(8);
+
+      (Codec<typename boost::fusion::result_of::value_at_c<StructT, I>::type>::encode(w, boost::fusion::at_c<I>(st)), ...);
+   }
+
+   template<typename IndexT = std::make_index_sequence<boost::fusion::result_of::size<StructT>::value>>
+   static inline
+   auto encode(WireWriter& w, const StructT& st) -> decltype(encode_members(w, st, IndexT()))
+   {
+      encode_members(w, st, IndexT());
+   }
+
    static inline
    void decode(DBusMessageIter& iter, StructT& st)
    {
       DBusMessageIter _iter;
-      simppl_dbus_message_iter_recurse(&iter, &_iter, DBUS_TYPE_STRUCT);
+      detail::iter_recurse(&iter, &_iter, DBUS_TYPE_STRUCT);
 
       boost::fusion::for_each(st, FusionDecoder(_iter));
 
@@ -222,6 +341,24 @@ struct StructSerializationHelper<StructT, boost::mpl::true_>
 
       return os << DBUS_STRUCT_END_CHAR_AS_STRING;
    }
+
+
+   template<std::size_t... I, typename = std::enable_if_t<
+      has_signature<Codec<typename boost::fusion::result_of::value_at_c<StructT, I>::type>...>::value>>
+   static constexpr
+   auto members_signature(std::index_sequence<I...>)
+   {
+      return (make_fixed_string(DBUS_STRUCT_BEGIN_CHAR_AS_STRING) + ... + Codec<typename boost::fusion::result_of::value_at_c<StructT, I>::type>::signature())
+         + make_fixed_string(DBUS_STRUCT_END_CHAR_AS_STRING);
+   }
+
+
+   template<typename IndexT = std::make_index_sequence<boost::fusion::result_of::size<StructT>::value>>
+   static constexpr
+   auto signature() -> decltype(members_signature(IndexT()))
+   {
+      return members_signature(IndexT());
+   }
 };
 
 #endif   // SIMPPL_HAVE_BOOST_FUSION
@@ -245,6 +382,20 @@ struct CodecImpl<T, Struct>
    }
 
 
+   template<typename HelperT = detail::StructSerializationHelper<T,
+#if SIMPPL_HAVE_BOOST_FUSION
+      typename boost::fusion::traits::is_sequence<T>::type
+#else
+      int /* just any type but mpl::true_*/
+#endif
+      >>
+   static inline
+   auto encode(detail::WireWriter& w, const T& st) -> decltype(HelperT::encode(w, st))
+   {
+      HelperT::encode(w, st);
+   }
+
+
    static
    void decode(DBusMessageIter& iter, T& st)
    {
@@ -270,6 +421,20 @@ struct CodecImpl<T, Struct>
       >::make_type_signature(os);
       return os;
    }
+
+
+   template<typename HelperT = detail::StructSerializationHelper<T,
+#if SIMPPL_HAVE_BOOST_FUSION
+      typename boost::fusion::traits::is_sequence<T>::type
+#else
+      int /* just any type but mpl::true_*/
+#endif
+      >>
+   static constexpr
+   auto signature() -> decltype(HelperT::signature())
+   {
+      return HelperT::signature();
+   }
 };
 
 
@@ -12,6 +12,7 @@
 #include "simppl/pendingcall.h"
 
 #include "simppl/detail/constants.h"
+#include "simppl/detail/function_ref.h"
 #include "simppl/detail/holders.h"
 
 #include "simppl/connectionstate.h"
@@ -127,6 +128,9 @@ public:
 
    DBusConnection* conn();
 
+   /// allocator for the callback holders of asynchronous calls
+   detail::CallbackPool& callback_pool();
+
    inline
    bool is_connected() const
    {
@@ -134,7 +138,7 @@ public:
    }
 
    inline
-   std::string busname() const
+   const std::string& busname() const
    {
       return busname_;
    }
@@ -162,9 +166,9 @@ protected:
 
    void cleanup();
 
-   PendingCall send_request(ClientMethodBase* method, std::function<void(DBusMessageIter&)>&& f, bool is_oneway);
+   PendingCall send_request(ClientMethodBase* method, detail::function_ref<void(message_ptr_t&)> f, bool is_oneway);
 
-   message_ptr_t send_request_and_block(ClientMethodBase* method, std::function<void(DBusMessageIter&)>&& f, bool is_oneway);
+   message_ptr_t send_request_and_block(ClientMethodBase* method, detail::function_ref<void(message_ptr_t&)> f, bool is_oneway);
 
    void register_signal(ClientSignalBase& sigbase);
    void unregister_signal(ClientSignalBase& sigbase);
@@ -182,14 +186,14 @@ protected:
    /**
     * Blocking call.
     */
-   void set_property(const char* Name, std::function<void(DBusMessageIter&)>&& f);
+   void set_property(const char* Name, detail::function_ref<void(DBusMessageIter&)> f);
 
    /**
     * Just register the property within the stub.
     */
    void add_property(ClientPropertyBase* property);
 
-   PendingCall set_property_async(const char* Name, std::function<void(DBusMessageIter&)>&& f);
+   PendingCall set_property_async(const char* Name, detail::function_ref<void(DBusMessageIter&)> f);
 
    /**
     * Second part of get_all_properties_async. Once the callback arrives
@@ -224,7 +228,7 @@ void operator>>(simppl::dbus::detail::InterimGetAllPropertiesCallbackHolder&& r,
 {
    dbus_pending_call_set_notify(r.pc_.pending(),
                                 &simppl::dbus::detail::GetAllPropertiesHolder::pending_notify,
-                                new simppl::dbus::detail::GetAllPropertiesHolder(f, r.stub_),
+                                r.pool_.make<simppl::dbus::detail::GetAllPropertiesHolder>(r.pool_, f, r.stub_),
                                 &simppl::dbus::detail::GetAllPropertiesHolder::_delete);
 }
 
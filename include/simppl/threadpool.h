@@ -0,0 +1,76 @@
+#ifndef SIMPPL_THREADPOOL_H
+#define SIMPPL_THREADPOOL_H
+
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+/**
+ * Fixed size pool of worker threads. Can be attached to skeletons or single
+ * server methods in order to run the request handlers off the dispatcher
+ * thread, see SkeletonBase::set_executor().
+ */
+struct ThreadPool
+{
+   ThreadPool(const ThreadPool&) = delete;
+   ThreadPool& operator=(const ThreadPool&) = delete;
+
+   /**
+    * @param threads number of worker threads, 0 means one per core.
+    */
+   explicit
+   ThreadPool(std::size_t threads = 0);
+
+   /**
+    * Runs all jobs still queued and joins the worker threads.
+    */
+   ~ThreadPool();
+
+   /**
+    * Queue a job for execution on any of the worker threads. May be called
+    * from any thread.
+    */
+   void post(std::function<void()> job);
+
+   inline
+   std::size_t size() const
+   {
+      return threads_.size();
+   }
+
+   /**
+    * @return the pool the calling thread belongs to or nullptr if the calling
+    *         thread is no worker thread.
+    */
+   static ThreadPool* current();
+
+private:
+
+   void run();
+
+   std::mutex mutex_;
+   std::condition_variable cond_;
+   std::deque<std::function<void()>> jobs_;
+   bool stopped_;
+
+   std::vector<std::thread> threads_;
+};
+
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+#endif   // SIMPPL_THREADPOOL_H
@@ -53,7 +53,7 @@ struct TupleDeserializer // : noncopable
     , flattened_(flattened)
    {
       if (!flattened)
-         simppl_dbus_message_iter_recurse(&orig_, &iter_, DBUS_TYPE_STRUCT);
+         detail::iter_recurse(&orig_, &iter_, DBUS_TYPE_STRUCT);
    }
 
    ~TupleDeserializer()
@@ -89,6 +89,15 @@ struct Codec<std::tuple<T...>>
    }
    
    
+   template<bool B = detail::has_wire_encoding<T...>::value, typename = std::enable_if_t<B>>
+   static
+   void encode(detail::WireWriter& w, const std::tuple<T...>& t)
+   {
+      w.align(8);
+      std::apply([&w](const T&... args){ simppl::dbus::encode(w, args...); }, t);
+   }
+   
+   
    static 
    void decode(DBusMessageIter& iter, std::tuple<T...>& t)
    {
@@ -136,6 +145,15 @@ struct Codec<std::tuple<T...>>
 
       return os;
    }
+
+
+   template<bool B = detail::has_signature<Codec<T>...>::value, typename = std::enable_if_t<B>>
+   static constexpr
+   auto signature()
+   {
+      return (detail::make_fixed_string(DBUS_STRUCT_BEGIN_CHAR_AS_STRING) + ... + Codec<T>::signature())
+         + detail::make_fixed_string(DBUS_STRUCT_END_CHAR_AS_STRING);
+   }
 };
 
 
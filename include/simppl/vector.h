@@ -12,7 +12,7 @@ namespace simppl
 
 namespace dbus
 {
-    
+
    
 template<typename T>
 struct Codec<std::vector<T>>
@@ -20,39 +20,81 @@ struct Codec<std::vector<T>>
    static 
    void encode(DBusMessageIter& s, const std::vector<T>& v)
    {
-      DBusMessageIter iter;
-      
-      std::ostringstream buf;
-      Codec<T>::make_type_signature(buf);
+      if constexpr(detail::is_fixed_array_element<T>::value)
+      {
+         detail::append_fixed_array(s, v.data(), v.size());
+      }
+      else
+      {
+         DBusMessageIter iter;
+         dbus_message_iter_open_container(&s, DBUS_TYPE_ARRAY, detail::type_signature<T>(), &iter);
 
-      dbus_message_iter_open_container(&s, DBUS_TYPE_ARRAY, buf.str().c_str(), &iter);
+         for (auto& t : v) 
+         {
+            Codec<T>::encode(iter, t);
+         }
 
-      for (auto& t : v) 
+         dbus_message_iter_close_container(&s, &iter);
+      }
+   }
+   
+   
+   template<bool B = detail::has_wire_encoding<T>::value, typename = std::enable_if_t<B>>
+   static
+   void encode(detail::WireWriter& w, const std::vector<T>& v)
+   {
+      if constexpr(detail::is_fixed_array_element<T>::value)
+      {
+         w.write_fixed_array(v.data(), v.size());
+      }
+      else if constexpr(detail::is_wire_layout_compatible<T>::value)
       {
-         Codec<T>::encode(iter, t);
+         // structs start 8-byte aligned
+         w.write_fixed_array(v.data(), v.size(), 8);
       }
+      else
+      {
+         auto arr = w.open_array(detail::wire_alignment(detail::signature_v<T>.c_str()[0]));
+
+         for (auto& t : v)
+         {
+            Codec<T>::encode(w, t);
+         }
 
-      dbus_message_iter_close_container(&s, &iter);
+         w.close_array(arr);
+      }
    }
    
    
    static 
    void decode(DBusMessageIter& s, std::vector<T>& v)
    {
-      v.clear();
-
-      DBusMessageIter iter;
-      simppl_dbus_message_iter_recurse(&s, &iter, DBUS_TYPE_ARRAY);
+      if constexpr(detail::is_fixed_array_element<T>::value)
+      {
+         const T* data;
+         std::size_t len = detail::get_fixed_array(s, data);
 
-      while(dbus_message_iter_get_arg_type(&iter) != 0)
+         v.assign(data, data + len);
+      }
+      else
       {
-         T t;
-         Codec<T>::decode(iter, t);
-         v.push_back(t);
+         v.clear();
+
+         DBusMessageIter iter;
+         detail::iter_recurse(&s, &iter, DBUS_TYPE_ARRAY);
+
+         // no reserve: libdbus counts the elements of variable sized
+         // types by walking the whole array which costs more than it saves
+         while(dbus_message_iter_get_arg_type(&iter) != 0)
+         {
+            // decode in place, no copy of the element
+            v.emplace_back();
+            Codec<T>::decode(iter, v.back());
+         }
+
+         // advance to next element
+         dbus_message_iter_next(&s);
       }
-
-      // advance to next element
-      dbus_message_iter_next(&s);
    }
    
    
@@ -62,6 +104,14 @@ struct Codec<std::vector<T>>
       return Codec<T>::make_type_signature(os << DBUS_TYPE_ARRAY_AS_STRING);
    }
 
+
+   template<bool B = detail::has_signature<Codec<T>>::value, typename = std::enable_if_t<B>>
+   static constexpr
+   auto signature()
+   {
+      return detail::make_fixed_string(DBUS_TYPE_ARRAY_AS_STRING) + Codec<T>::signature();
+   }
+
 };
 
    
@@ -29,6 +29,12 @@ struct WStringCodec
    
    static
    std::ostream& make_type_signature(std::ostream& os);
+
+   static constexpr
+   auto signature()
+   {
+      return detail::make_fixed_string(DBUS_TYPE_ARRAY_AS_STRING DBUS_TYPE_UINT32_AS_STRING);
+   }
 };
 
    
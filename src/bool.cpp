@@ -20,7 +20,7 @@ void BoolCodec::encode(DBusMessageIter& iter, bool b)
 void BoolCodec::decode(DBusMessageIter& iter, bool& t)
 {
    dbus_bool_t b;
-   simppl_dbus_message_iter_get_basic(&iter, &b, DBUS_TYPE_BOOLEAN);
+   detail::iter_get_basic(&iter, &b, DBUS_TYPE_BOOLEAN);
    
    t = b;
 }
@@ -0,0 +1,101 @@
+#include "simppl/detail/callbackpool.h"
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+namespace detail
+{
+
+CallbackPool::CallbackPool()
+ : refs_(1)
+{
+   for (auto& f : free_)
+      f = nullptr;
+}
+
+
+CallbackPool::~CallbackPool()
+{
+   for (auto f : free_)
+   {
+      while(f)
+      {
+         Block* next = f->next_;
+         ::operator delete(f);
+         f = next;
+      }
+   }
+}
+
+
+void CallbackPool::release()
+{
+   unref();
+}
+
+
+void CallbackPool::unref()
+{
+   if (--refs_ == 0)
+      delete this;
+}
+
+
+void* CallbackPool::allocate(std::size_t size)
+{
+   std::size_t idx = (size - 1) / granularity;
+
+   if (idx < classes)
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      ++refs_;
+
+      if (Block* b = free_[idx])
+      {
+         free_[idx] = b->next_;
+         return b;
+      }
+   }
+   else
+      ++refs_;
+
+   try
+   {
+      return ::operator new(idx < classes ? (idx + 1) * granularity : size);
+   }
+   catch(...)
+   {
+      unref();
+      throw;
+   }
+}
+
+
+void CallbackPool::deallocate(void* p, std::size_t size)
+{
+   std::size_t idx = (size - 1) / granularity;
+
+   if (idx < classes)
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      Block* b = (Block*)p;
+      b->next_ = free_[idx];
+      free_[idx] = b;
+   }
+   else
+      ::operator delete(p);
+
+   unref();
+}
+
+}   // namespace detail
+
+}   // namespace dbus
+
+}   // namespace simppl
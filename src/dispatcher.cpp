@@ -1,14 +1,24 @@
 #include "simppl/dispatcher.h"
 
-#include <sys/timerfd.h>
-#include <sys/poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 
 #include <unistd.h>
+#include <cassert>
 
+#include <algorithm>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
 
+#include "simppl/detail/callbackpool.h"
 #include "simppl/detail/util.h"
 #include "simppl/timeout.h"
 #include "simppl/skeletonbase.h"
@@ -20,6 +30,8 @@
 #include "simppl/clientside.h"
 #undef SIMPPL_DISPATCHER_CPP
 
+#include "simppl/objectmanagerclient.h"
+
 #define SIMPPL_USE_POLL
 
 using namespace std::placeholders;
@@ -73,39 +85,168 @@ DBusHandlerResult signal_filter(DBusConnection* /*connection*/, DBusMessage* msg
 }
 
 
-short make_poll_events(int flags)
+uint32_t make_epoll_events(int flags)
 {
-    short rc = 0;
+    uint32_t rc = 0;
 
     if (flags & DBUS_WATCH_READABLE)
-        rc |= POLLIN;
+        rc |= EPOLLIN;
     if (flags & DBUS_WATCH_WRITABLE)
-        rc |= POLLOUT;
-
-    // do not expect to have read and write simultaneously from DBus API
-    assert(flags | ((DBUS_WATCH_READABLE&DBUS_WATCH_WRITABLE) != (DBUS_WATCH_READABLE&DBUS_WATCH_WRITABLE)));
+        rc |= EPOLLOUT;
 
     return rc;
 }
 
 
-int make_dbus_flags(short events)
+int make_dbus_flags(uint32_t events)
 {
     int rc = 0;
 
-    if (events & POLLIN)
+    if (events & EPOLLIN)
         rc |= DBUS_WATCH_READABLE;
-    if (events & POLLOUT)
+    if (events & EPOLLOUT)
         rc |= DBUS_WATCH_WRITABLE;
-    if (events & POLLHUP)
+    if (events & EPOLLHUP)
         rc |= DBUS_WATCH_HANGUP;
-    if (events & POLLERR)
+    if (events & EPOLLERR)
         rc |= DBUS_WATCH_ERROR;
 
     return rc;
 }
 
 
+/**
+ * A single DBus timeout or deferred task scheduled within the dispatcher's
+ * timer heap.
+ */
+struct Timer
+{
+    static constexpr std::size_t npos = std::size_t(-1);
+
+    std::chrono::steady_clock::time_point due_;
+    std::size_t index_ = npos;   ///< position within the heap or npos if not scheduled
+    DBusTimeout* timeout_ = nullptr;
+    std::function<void()> task_;   ///< set for tasks from post_at()
+};
+
+
+/**
+ * Node of the dispatcher's intrusive multi-producer task queue.
+ */
+struct PostedTask
+{
+    explicit
+    PostedTask(std::function<void()>&& func)
+     : next_(nullptr)
+     , func_(std::move(func))
+    {
+        // NOOP
+    }
+
+    PostedTask* next_;
+    std::function<void()> func_;
+};
+
+
+/**
+ * Indexed binary min-heap of timers ordered by due time. Scheduling and
+ * cancelling a timer is O(log n) and needs no system call at all, the
+ * eventloop just uses the earliest due time as the epoll timeout.
+ */
+class TimerHeap
+{
+public:
+
+    bool empty() const
+    {
+        return heap_.empty();
+    }
+
+    Timer* top() const
+    {
+        return heap_.front();
+    }
+
+    void push(Timer* t)
+    {
+        assert(t->index_ == Timer::npos);
+
+        t->index_ = heap_.size();
+        heap_.push_back(t);
+
+        sift_up(t->index_);
+    }
+
+    void erase(Timer* t)
+    {
+        assert(t->index_ < heap_.size() && heap_[t->index_] == t);
+
+        std::size_t index = t->index_;
+        t->index_ = Timer::npos;
+
+        Timer* last = heap_.back();
+        heap_.pop_back();
+
+        if (last != t)
+        {
+            heap_[index] = last;
+            last->index_ = index;
+
+            sift_up(index);
+            sift_down(last->index_);
+        }
+    }
+
+private:
+
+    void swap(std::size_t i, std::size_t j)
+    {
+        std::swap(heap_[i], heap_[j]);
+
+        heap_[i]->index_ = i;
+        heap_[j]->index_ = j;
+    }
+
+    void sift_up(std::size_t i)
+    {
+        while(i > 0)
+        {
+            std::size_t parent = (i - 1) / 2;
+
+            if (heap_[parent]->due_ <= heap_[i]->due_)
+                break;
+
+            swap(i, parent);
+            i = parent;
+        }
+    }
+
+    void sift_down(std::size_t i)
+    {
+        for(;;)
+        {
+            std::size_t smallest = i;
+            std::size_t left = 2 * i + 1;
+            std::size_t right = left + 1;
+
+            if (left < heap_.size() && heap_[left]->due_ < heap_[smallest]->due_)
+                smallest = left;
+
+            if (right < heap_.size() && heap_[right]->due_ < heap_[smallest]->due_)
+                smallest = right;
+
+            if (smallest == i)
+                break;
+
+            swap(i, smallest);
+            i = smallest;
+        }
+    }
+
+    std::vector<Timer*> heap_;
+};
+
+
 }   // namespace
 
 
@@ -139,6 +280,14 @@ void dispatcher_add_skeleton(Dispatcher& disp, SkeletonBase& stub)
 
 struct Dispatcher::Private
 {
+    /// all DBus watches registered on a single file descriptor
+    struct WatchSet
+    {
+        std::vector<DBusWatch*> watches_;
+        uint32_t events_ = 0;   ///< events currently registered within epoll
+    };
+
+
     static
     dbus_bool_t add_watch(DBusWatch *watch, void *data)
     {
@@ -175,101 +324,320 @@ struct Dispatcher::Private
         ((simppl::dbus::Dispatcher::Private*)data)->toggle_timeout(timeout);
     }
 
+    static
+    void wakeup_main(void *data)
+    {
+        ((simppl::dbus::Dispatcher::Private*)data)->wakeup();
+    }
+
+    static
+    void dispatch_status(DBusConnection*, DBusDispatchStatus status, void *data)
+    {
+        if (status == DBUS_DISPATCH_DATA_REMAINS)
+            ((simppl::dbus::Dispatcher::Private*)data)->wakeup();
+    }
+
 
     Private()
      : running_(false)
+     , epollfd_(::epoll_create1(EPOLL_CLOEXEC))
+     , wakeupfd_(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+     , tasks_(nullptr)
+     , ready_(nullptr)
+     , iterations_(0)
+     , messages_dispatched_(0)
+     , timeouts_handled_(0)
+     , tasks_run_(0)
+     , callbacks_(new detail::CallbackPool)
+     , registrations_(0)
     {
-      // NOOP
+        if (epollfd_ < 0 || wakeupfd_ < 0)
+        {
+            if (epollfd_ >= 0)
+                ::close(epollfd_);
+
+            if (wakeupfd_ >= 0)
+                ::close(wakeupfd_);
+
+            callbacks_->release();
+
+            throw std::runtime_error("epoll_create1/eventfd failed");
+        }
+
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = wakeupfd_;
+
+        ::epoll_ctl(epollfd_, EPOLL_CTL_ADD, wakeupfd_, &ev);
     }
 
 
-    dbus_bool_t add_watch(DBusWatch* w)
+    ~Private()
+    {
+        free_tasks(tasks_.exchange(nullptr));
+        free_tasks(ready_);
+
+        ::close(wakeupfd_);
+        ::close(epollfd_);
+
+        // outstanding pending calls may still hold callbacks
+        callbacks_->release();
+    }
+
+
+    /**
+     * Interrupt a blocking poll(). May be called from any thread.
+     */
+    void wakeup()
     {
-       //std::cout << "add_watch" << std::endl;
-        pollfd fd = { 0 };
+        uint64_t one = 1;
+
+        // an overflowing counter already means pending wakeup
+        (void)::write(wakeupfd_, &one, sizeof(one));
+    }
 
-        fd.fd = dbus_watch_get_unix_fd(w);
 
-        if (dbus_watch_get_enabled(w))
+    /**
+     * Lock-free push onto the task stack. May be called from any thread.
+     */
+    void push_task(PostedTask* t)
+    {
+        PostedTask* head = tasks_.load(std::memory_order_relaxed);
+
+        do
         {
-            fd.events = make_poll_events(dbus_watch_get_flags(w));
-            fds_.push_back(fd);
+            t->next_ = head;
         }
-        //else
-          // std::cout << "Not enabled" << std::endl;
+        while(!tasks_.compare_exchange_weak(head, t, std::memory_order_release, std::memory_order_relaxed));
 
-        watch_handlers_.emplace(fd.fd, w);
+        // only the first task of a batch has to interrupt the loop
+        if (!head)
+            wakeup();
+    }
 
-        return TRUE;
+
+    /**
+     * Run all tasks posted so far in the order they were posted.
+     */
+    void run_tasks()
+    {
+        if (!ready_)
+        {
+            // take the whole batch at once and restore FIFO order
+            PostedTask* t = tasks_.exchange(nullptr, std::memory_order_acquire);
+
+            while(t)
+            {
+                PostedTask* next = t->next_;
+                t->next_ = ready_;
+                ready_ = t;
+                t = next;
+            }
+        }
+
+        // if a task throws, the remaining ones are run on the next iteration
+        while(ready_)
+        {
+            std::unique_ptr<PostedTask> t(ready_);
+            ready_ = t->next_;
+
+            ++tasks_run_;
+            t->func_();
+        }
     }
 
 
-    void remove_watch(DBusWatch* w)
+    static
+    void free_tasks(PostedTask* t)
     {
-       //std::cout << "remove_watch" << std::endl;
-       auto result = watch_handlers_.equal_range(dbus_watch_get_unix_fd(w));
+        while(t)
+        {
+            PostedTask* next = t->next_;
+            delete t;
+            t = next;
+        }
+    }
 
-       for(auto iter = result.first; iter != result.second; ++iter)
-       {
-          if (iter->second == w)
-          {
-             auto pfditer = std::find_if(fds_.begin(), fds_.end(), [w](auto& pfd){
-                return dbus_watch_get_unix_fd(w) == pfd.fd
-                    && pfd.revents & make_poll_events(dbus_watch_get_flags(w));
-             });
-
-             if (pfditer != fds_.end())
-             {
-//                std::cout << "ok found" << std::endl;
-                 fds_.erase(pfditer);
-             }
-             watch_handlers_.erase(iter);
-             break;
-          }
-       }
+
+    void schedule_task(std::chrono::steady_clock::time_point due, std::function<void()>&& task)
+    {
+        Timer* t = alloc_timer();
+
+        t->due_ = due;
+        t->task_ = std::move(task);
+
+        timers_heap_.push(t);
     }
 
 
-    void toggle_watch(DBusWatch* w)
+    void clear_wakeup()
     {
-       assert(false);   // not implemented
-        /*   auto iter = std::find_if(fds_.begin(), fds_.end(), [w](auto& pfd){ return dbus_watch_get_unix_fd(w) == pfd.fd; });
-        if (iter != fds_.end())
+        uint64_t value;
+        (void)::read(wakeupfd_, &value, sizeof(value));
+    }
+
+
+    /**
+     * Set the epoll registration of the given fd according to the union
+     * of all enabled watches on the fd. DBus may install a read and a write
+     * watch on the same file descriptor.
+     */
+    void update_watches(int fd, WatchSet& set)
+    {
+        uint32_t events = 0;
+
+        for(auto w : set.watches_)
         {
             if (dbus_watch_get_enabled(w))
+                events |= make_epoll_events(dbus_watch_get_flags(w));
+        }
+
+        if (events != set.events_)
+        {
+            epoll_event ev = {};
+            ev.events = events;
+            ev.data.fd = fd;
+
+            if (set.events_ == 0)
+            {
+                ::epoll_ctl(epollfd_, EPOLL_CTL_ADD, fd, &ev);
+            }
+            else if (events == 0)
             {
-                iter->events = make_poll_events(dbus_watch_get_flags(w));
+                ::epoll_ctl(epollfd_, EPOLL_CTL_DEL, fd, &ev);
             }
             else
-                iter->events = 0;
-        }*/
+                ::epoll_ctl(epollfd_, EPOLL_CTL_MOD, fd, &ev);
+
+            set.events_ = events;
+        }
     }
 
 
-    dbus_bool_t add_timeout(DBusTimeout* t)
+    dbus_bool_t add_watch(DBusWatch* w)
+    {
+        int fd = dbus_watch_get_unix_fd(w);
+
+        auto& set = watch_handlers_[fd];
+        set.watches_.push_back(w);
+
+        update_watches(fd, set);
+
+        return TRUE;
+    }
+
+
+    void remove_watch(DBusWatch* w)
+    {
+        auto iter = watch_handlers_.find(dbus_watch_get_unix_fd(w));
+
+        if (iter != watch_handlers_.end())
+        {
+            auto& watches = iter->second.watches_;
+            watches.erase(std::remove(watches.begin(), watches.end(), w), watches.end());
+
+            update_watches(iter->first, iter->second);
+
+            if (watches.empty())
+                watch_handlers_.erase(iter);
+        }
+    }
+
+
+    void toggle_watch(DBusWatch* w)
+    {
+        auto iter = watch_handlers_.find(dbus_watch_get_unix_fd(w));
+
+        if (iter != watch_handlers_.end())
+            update_watches(iter->first, iter->second);
+    }
+
+
+    void handle_watches(int fd, uint32_t events)
     {
-        pollfd fd;
-        fd.fd = timerfd_create(CLOCK_MONOTONIC, 0);
-        fd.events = POLLIN;
+        auto iter = watch_handlers_.find(fd);
+
+        if (iter == watch_handlers_.end())
+            return;
+
+        // handling a watch may add or remove watches, so work on a copy
+        // and re-check each watch before calling into DBus; libdbus uses
+        // at most a read and a write watch per fd, more are copied to the heap
+        auto& fd_watches = iter->second.watches_;
+        std::size_t count = fd_watches.size();
+
+        DBusWatch* local[4];
+        std::vector<DBusWatch*> more;
+        DBusWatch** watches = local;
+
+        if (count > sizeof(local) / sizeof(local[0]))
+        {
+            more.assign(fd_watches.begin(), fd_watches.end());
+            watches = more.data();
+        }
+        else
+            std::copy_n(fd_watches.begin(), count, local);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                iter = watch_handlers_.find(fd);
+
+                if (iter == watch_handlers_.end())
+                    break;
+
+                auto& current = iter->second.watches_;
+                if (std::find(current.begin(), current.end(), watches[i]) == current.end())
+                    continue;
+            }
+
+            if (!dbus_watch_get_enabled(watches[i]))
+                continue;
 
-        //std::cout << "add_timeout fd=" << fd.fd << std::endl;
+            int flags = make_dbus_flags(events) & (dbus_watch_get_flags(watches[i]) | DBUS_WATCH_HANGUP | DBUS_WATCH_ERROR);
 
-        if (dbus_timeout_get_enabled(t))
+            if (flags)
+                dbus_watch_handle(watches[i], flags);
+        }
+    }
+
+
+    Timer* alloc_timer()
+    {
+        if (free_timers_.empty())
         {
-            int interval_ms = dbus_timeout_get_interval(t);
+            timers_.emplace_back(new Timer);
+            return timers_.back().get();
+        }
+
+        Timer* t = free_timers_.back();
+        free_timers_.pop_back();
+
+        return t;
+    }
 
-            struct itimerspec spec = {
-                { interval_ms / 1000, (interval_ms % 1000) * 1000000L },
-                { interval_ms / 1000, (interval_ms % 1000) * 1000000L }
-            };
 
-            timerfd_settime(fd.fd, 0, &spec, 0);
+    void schedule(Timer* t, std::chrono::steady_clock::time_point now)
+    {
+        if (dbus_timeout_get_enabled(t->timeout_))
+        {
+            // DBus timeouts are periodic; avoid spinning on zero intervals
+            int interval_ms = std::max(1, dbus_timeout_get_interval(t->timeout_));
+
+            t->due_ = now + std::chrono::milliseconds(interval_ms);
+            timers_heap_.push(t);
         }
+    }
 
-        dbus_timeout_set_data(t, reinterpret_cast<void*>(fd.fd), 0);
 
-        fds_.push_back(fd);
-        tm_handlers_[fd.fd] = t;
+    dbus_bool_t add_timeout(DBusTimeout* t)
+    {
+        Timer* tm = alloc_timer();
+        tm->timeout_ = t;
+
+        dbus_timeout_set_data(t, tm, nullptr);
+        schedule(tm, std::chrono::steady_clock::now());
 
         return TRUE;
     }
@@ -277,86 +645,120 @@ struct Dispatcher::Private
 
     void remove_timeout(DBusTimeout* t)
     {
-        //std::cout << "remove_timeout fd=" << reinterpret_cast<int>(dbus_timeout_get_data(t)) << std::endl;
-        auto iter = std::find_if(fds_.begin(), fds_.end(), [t](auto& pfd){ return reinterpret_cast<int64_t>(dbus_timeout_get_data(t)) == pfd.fd; });
-        if (iter != fds_.end())
+        Timer* tm = static_cast<Timer*>(dbus_timeout_get_data(t));
+
+        if (tm)
         {
-            tm_handlers_.erase(iter->fd);
-            ::close(iter->fd);
+            if (tm->index_ != Timer::npos)
+                timers_heap_.erase(tm);
 
-            fds_.erase(iter);
+            tm->timeout_ = nullptr;
+            free_timers_.push_back(tm);
+
+            dbus_timeout_set_data(t, nullptr, nullptr);
         }
     }
 
 
     void toggle_timeout(DBusTimeout* t)
     {
-        //std::cout << "toggle_timeout" << std::endl;
-        auto iter = std::find_if(fds_.begin(), fds_.end(), [t](auto& pfd){ return reinterpret_cast<int64_t>(dbus_timeout_get_data(t)) == pfd.fd; });
-        if (iter != fds_.end())
+        Timer* tm = static_cast<Timer*>(dbus_timeout_get_data(t));
+
+        if (tm)
         {
-            if (dbus_timeout_get_enabled(t))
-            {
-                int interval_ms = dbus_timeout_get_interval(t);
+            if (tm->index_ != Timer::npos)
+                timers_heap_.erase(tm);
 
-                struct itimerspec spec = {
-                    { interval_ms / 1000, (interval_ms % 1000) * 1000000L },
-                    { interval_ms / 1000, (interval_ms % 1000) * 1000000L }
-                };
+            schedule(tm, std::chrono::steady_clock::now());
+        }
+    }
 
-                timerfd_settime(iter->fd, 0, &spec, 0);
+
+    /**
+     * @return the epoll timeout to use so that the earliest timer due is
+     *         not missed. @c timeout is the upper bound as requested by the
+     *         caller, -1 means infinite.
+     */
+    int next_timeout(int timeout) const
+    {
+        // left over tasks from an interrupted batch
+        if (ready_)
+            return 0;
+
+        if (!timers_heap_.empty())
+        {
+            auto delta = std::chrono::ceil<std::chrono::milliseconds>(timers_heap_.top()->due_ - std::chrono::steady_clock::now()).count();
+
+            if (delta < 0)
+                delta = 0;
+
+            if (timeout < 0 || delta < timeout)
+                timeout = static_cast<int>(delta);
+        }
+
+        return timeout;
+    }
+
+
+    void handle_timeouts()
+    {
+        auto now = std::chrono::steady_clock::now();
+
+        while(!timers_heap_.empty() && timers_heap_.top()->due_ <= now)
+        {
+            Timer* t = timers_heap_.top();
+            timers_heap_.erase(t);
+
+            if (t->timeout_)
+            {
+                // re-schedule first, the handler may remove the timeout
+                schedule(t, now);
+                ++timeouts_handled_;
+                dbus_timeout_handle(t->timeout_);
             }
             else
-                timerfd_settime(iter->fd, 0, 0, 0);
+            {
+                std::function<void()> task(std::move(t->task_));
+
+                t->task_ = nullptr;
+                free_timers_.push_back(t);
+
+                ++tasks_run_;
+                task();
+            }
         }
     }
 
 
     int poll(int timeout)
     {
-        //std::cout << "poll" << std::endl;
-        if (::poll(&fds_[0], fds_.size(), timeout) > 0)
+        epoll_event events[max_events];
+        int n;
+
+        ++iterations_;
+
+        // service every ready descriptor, not just the first one
+        do
         {
-            for(auto& pfd : fds_)
+            n = ::epoll_wait(epollfd_, events, max_events, next_timeout(timeout));
+
+            for (int i = 0; i < n; ++i)
             {
-                if (pfd.revents)
+                if (events[i].data.fd == wakeupfd_)
                 {
-                    auto result = watch_handlers_.equal_range(pfd.fd);
-                    bool handled = false;
-
-                    for(auto iter = result.first; iter != result.second; ++iter)
-                    {
-                       handled = true;   // ok, fd found...
-
-                       if (pfd.revents & make_poll_events(dbus_watch_get_flags(iter->second)))
-                       {
-                           //std::cout << "handle watch" << std::endl;
-                           dbus_watch_handle(iter->second, make_dbus_flags(pfd.revents));
-                           break;
-                        }
-                    }
-
-                    // must be a timeout
-                    if (!handled)
-                    {
-                        auto t_iter = tm_handlers_.find(pfd.fd);
-
-                        if (t_iter != tm_handlers_.end())
-                        {
-                            int64_t data;
-
-                            int rc = ::read(pfd.fd, &data, sizeof(data));
-                            (void)rc;
-
-//                            std::cout << "handle timeout" << std::endl;
-                            dbus_timeout_handle(t_iter->second);
-                        }
-                    }
-
-                    break;
+                    clear_wakeup();
                 }
+                else
+                    handle_watches(events[i].data.fd, events[i].events);
             }
+
+            // more events may be pending, fetch them without blocking
+            timeout = 0;
         }
+        while(n == max_events);
+
+        handle_timeouts();
+        run_tasks();
 
         return 0;
     }
@@ -364,22 +766,53 @@ struct Dispatcher::Private
 
     void init(DBusConnection* conn)
     {
-        dbus_connection_set_watch_functions(conn, &add_watch, &remove_watch, nullptr, this, nullptr);
+        dbus_connection_set_watch_functions(conn, &add_watch, &remove_watch, &toggle_watch, this, nullptr);
         dbus_connection_set_timeout_functions (conn, &add_timeout, &remove_timeout, &toggle_timeout, this, nullptr);
+        dbus_connection_set_wakeup_main_function(conn, &wakeup_main, this, nullptr);
+        dbus_connection_set_dispatch_status_function(conn, &dispatch_status, this, nullptr);
+
+        // messages may already be queued, e.g. from blocking calls done
+        // before the loop was started
+        if (dbus_connection_get_dispatch_status(conn) == DBUS_DISPATCH_DATA_REMAINS)
+            wakeup();
     }
 
 
+    static constexpr int max_events = 64;
+
     std::atomic_bool running_;
-    std::vector<pollfd> fds_;
+    int epollfd_;
+    int wakeupfd_;   ///< eventfd to interrupt a blocking poll
 
-    std::multimap<int, DBusWatch*> watch_handlers_;
-    std::map<int, DBusTimeout*> tm_handlers_;
+    std::unordered_map<int, WatchSet> watch_handlers_;
+
+    TimerHeap timers_heap_;
+    std::vector<std::unique_ptr<Timer>> timers_;   ///< owns all timer records
+    std::vector<Timer*> free_timers_;               ///< recycled timer records
+
+    std::atomic<PostedTask*> tasks_;   ///< posted tasks, pushed in LIFO order
+    PostedTask* ready_;                ///< current batch in FIFO order, only touched by the loop
+
+    // statistics, only written by the loop thread
+    std::atomic<uint64_t> iterations_;
+    std::atomic<uint64_t> messages_dispatched_;
+    std::atomic<uint64_t> timeouts_handled_;
+    std::atomic<uint64_t> tasks_run_;
+
+    detail::CallbackPool* callbacks_;
+
+    std::atomic<unsigned int> registrations_;   ///< object path (un)registrations
 
     std::multimap<std::string, StubBase*, std::less<>> stubs_;
+    std::vector<ObjectManagerClient*> managers_;
     std::map<std::string, int> signal_matches_;
 
     /// service registration's list
     std::set<std::string> busnames_;
+
+    /// names requested by servers, each is only requested once
+    std::mutex owned_names_mutex_;
+    std::set<std::string, std::less<>> owned_names_;
 };
 
 
@@ -541,11 +974,21 @@ void Dispatcher::add_server(SkeletonBase& serv)
    dbus_error_init(&err);
 
    if (serv.busname()[0] != '\0')
-      dbus_bus_request_name(conn_, serv.busname(), 0, &err);
-
-   if (dbus_error_is_set(&err))
    {
-      throw RuntimeError("dbus_bus_request_name", std::move(err));
+      // many objects usually share a busname, avoid the roundtrip
+      std::lock_guard<std::mutex> lock(d->owned_names_mutex_);
+
+      if (d->owned_names_.find(serv.busname()) == d->owned_names_.end())
+      {
+         dbus_bus_request_name(conn_, serv.busname(), 0, &err);
+
+         if (dbus_error_is_set(&err))
+         {
+            throw RuntimeError("dbus_bus_request_name", std::move(err));
+         }
+
+         d->owned_names_.insert(serv.busname());
+      }
    }
 
    // register same path as busname, just with / instead of .
@@ -560,12 +1003,34 @@ void Dispatcher::add_server(SkeletonBase& serv)
    }
 
    serv.disp_ = this;
+   ++d->registrations_;
 }
 
 
 void Dispatcher::remove_server(SkeletonBase& serv)
 {
     dbus_connection_unregister_object_path(conn_, serv.objectpath());
+    ++d->registrations_;
+}
+
+
+unsigned int Dispatcher::registrations() const
+{
+    return d->registrations_;
+}
+
+
+void Dispatcher::add_object_manager_client(ObjectManagerClient& clnt, const std::string& match_string)
+{
+    register_signal_match(match_string);
+    d->managers_.push_back(&clnt);
+}
+
+
+void Dispatcher::remove_object_manager_client(ObjectManagerClient& clnt, const std::string& match_string)
+{
+    d->managers_.erase(std::find(d->managers_.begin(), d->managers_.end(), &clnt));
+    unregister_signal_match(match_string);
 }
 
 
@@ -692,6 +1157,13 @@ DBusHandlerResult Dispatcher::try_handle_signal(DBusMessage* msg)
         // ordinary signals...
 
         bool handled = false;
+
+        if (!d->managers_.empty() && !strcmp(dbus_message_get_member(msg), "PropertiesChanged"))
+        {
+            // each manager checks path and sender itself
+            for (auto mgr : d->managers_)
+                handled |= mgr->try_handle_properties_changed(*msg);
+        }
         auto range = d->stubs_.equal_range(dbus_message_get_path(msg));
 
         for (auto iter = range.first; iter != range.second; ++iter)
@@ -714,6 +1186,24 @@ DBusHandlerResult Dispatcher::try_handle_signal(DBusMessage* msg)
 void Dispatcher::stop()
 {
    d->running_.store(false);
+
+   // interrupt a blocking poll so the loop sees the flag immediately
+   d->wakeup();
+}
+
+
+void Dispatcher::post(std::function<void()> task)
+{
+   d->push_task(new PostedTask(std::move(task)));
+}
+
+
+void Dispatcher::post_at(std::chrono::steady_clock::time_point deadline, std::function<void()> task)
+{
+   // the timer heap is owned by the loop thread
+   post([this, deadline, task = std::move(task)]() mutable {
+      d->schedule_task(deadline, std::move(task));
+   });
 }
 
 
@@ -758,12 +1248,34 @@ void Dispatcher::dispatch()
 
     do
     {
+       if (dbus_connection_get_dispatch_status(conn_) == DBUS_DISPATCH_DATA_REMAINS)
+          ++d->messages_dispatched_;
+
        rc = dbus_connection_dispatch(conn_);
     }
     while(rc != DBUS_DISPATCH_COMPLETE);
 }
 
 
+detail::CallbackPool& Dispatcher::callback_pool()
+{
+   return *d->callbacks_;
+}
+
+
+Dispatcher::Statistics Dispatcher::statistics() const
+{
+    Statistics stats;
+
+    stats.iterations = d->iterations_.load(std::memory_order_relaxed);
+    stats.messages = d->messages_dispatched_.load(std::memory_order_relaxed);
+    stats.timeouts = d->timeouts_handled_.load(std::memory_order_relaxed);
+    stats.tasks = d->tasks_run_.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+
 int Dispatcher::step_ms(int timeout_ms)
 {
 #ifdef SIMPPL_USE_POLL
@@ -771,7 +1283,7 @@ int Dispatcher::step_ms(int timeout_ms)
 
     dispatch();
 #else
-    dbus_connection_read_write_dispatch(conn_, 100);
+    dbus_connection_read_write_dispatch(conn_, timeout_ms);
 #endif
 
    return 0;
@@ -792,9 +1304,10 @@ int Dispatcher::run()
 
    d->running_.store(true);
 
+   // block until I/O, the earliest timeout or an explicit wakeup
    while(d->running_.load())
    {
-       step_ms(100);
+       step_ms(-1);
    }
 
    return 0;
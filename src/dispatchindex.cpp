@@ -0,0 +1,134 @@
+#include "simppl/detail/dispatchindex.h"
+
+#include <cstring>
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+namespace detail
+{
+
+namespace
+{
+
+/// word-wise hash, the names are mostly longer than a word
+inline
+std::size_t mix(std::size_t h, const char* str)
+{
+   constexpr uint64_t k = 0x9e3779b97f4a7c15ull;
+
+   std::size_t len = strlen(str);
+
+   for (; len >= sizeof(uint64_t); len -= sizeof(uint64_t), str += sizeof(uint64_t))
+   {
+      uint64_t w;
+      memcpy(&w, str, sizeof(w));
+
+      h = (h ^ w) * k;
+      h ^= h >> 32;
+   }
+
+   // a loop is faster than a variable sized memcpy here
+   uint64_t w = 0;
+   for (std::size_t i = 0; i < len; ++i)
+      w |= uint64_t((unsigned char)str[i]) << (8 * i);
+
+   // the tail length is mixed in, so "a.b" + "c" and "a.bc" differ
+   h = (h ^ w ^ len) * k;
+
+   // final avalanche, the table is indexed by the low bits
+   h ^= h >> 33;
+   h *= 0xff51afd7ed558ccdull;
+   return h ^ (h >> 33);
+}
+
+}   // namespace
+
+
+DispatchIndex::DispatchIndex()
+ : size_(0)
+{
+   // NOOP
+}
+
+
+void DispatchIndex::clear()
+{
+   entries_.clear();
+   size_ = 0;
+}
+
+
+std::size_t DispatchIndex::hash(Kind kind, const char* iface, const char* member)
+{
+   return mix(mix(kind, iface), member);
+}
+
+
+void DispatchIndex::rehash(std::size_t capacity)
+{
+   std::vector<Entry> entries(capacity, Entry{0, nullptr, nullptr, 0, 0, Interface});
+   entries.swap(entries_);
+
+   for (auto& e : entries)
+   {
+      if (e.iface_)
+      {
+         std::size_t i = e.hash_ & (capacity - 1);
+
+         while(entries_[i].iface_)
+            i = (i + 1) & (capacity - 1);
+
+         entries_[i] = e;
+      }
+   }
+}
+
+
+void DispatchIndex::insert(Kind kind, const char* iface, const char* member, int iface_id, std::ptrdiff_t offset)
+{
+   if (find(kind, iface, member))
+      return;
+
+   // keep the load factor below 1/2
+   if ((size_ + 1) * 2 > entries_.size())
+      rehash(entries_.empty() ? 16 : entries_.size() * 2);
+
+   std::size_t h = hash(kind, iface, member);
+   std::size_t i = h & (entries_.size() - 1);
+
+   while(entries_[i].iface_)
+      i = (i + 1) & (entries_.size() - 1);
+
+   entries_[i] = Entry{h, iface, member, offset, iface_id, kind};
+   ++size_;
+}
+
+
+const DispatchIndex::Entry* DispatchIndex::find(Kind kind, const char* iface, const char* member) const
+{
+   if (entries_.empty())
+      return nullptr;
+
+   std::size_t h = hash(kind, iface, member);
+
+   for (std::size_t i = h & (entries_.size() - 1); entries_[i].iface_; i = (i + 1) & (entries_.size() - 1))
+   {
+      const Entry& e = entries_[i];
+
+      if (e.hash_ == h && e.kind_ == kind && !strcmp(e.member_, member) && !strcmp(e.iface_, iface))
+         return &e;
+   }
+
+   return nullptr;
+}
+
+}   // namespace detail
+
+}   // namespace dbus
+
+}   // namespace simppl
@@ -155,7 +155,7 @@ void FileDescriptorCodec::encode(DBusMessageIter& iter, const FileDescriptor& fd
 void FileDescriptorCodec::decode(DBusMessageIter& iter, FileDescriptor& fd)
 {
    int _fd;
-   simppl_dbus_message_iter_get_basic(&iter, &_fd, DBUS_TYPE_UNIX_FD);
+   detail::iter_get_basic(&iter, &_fd, DBUS_TYPE_UNIX_FD);
    fd = _fd;
 }
 
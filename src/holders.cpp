@@ -4,9 +4,10 @@
 #include "simppl/detail/holders.h"
 
 
-simppl::dbus::detail::GetAllPropertiesHolder::GetAllPropertiesHolder(std::function<void(const CallState&)> f, StubBase& stub)
+simppl::dbus::detail::GetAllPropertiesHolder::GetAllPropertiesHolder(CallbackPool& pool, std::function<void(const CallState&)> f, StubBase& stub)
  : f_(f)
  , stub_(stub)
+ , pool_(pool)
 {
   // NOOP
 }
@@ -16,7 +17,7 @@ simppl::dbus::detail::GetAllPropertiesHolder::GetAllPropertiesHolder(std::functi
 void simppl::dbus::detail::GetAllPropertiesHolder::_delete(void* p)
 {
   auto that = (GetAllPropertiesHolder*)p;
-  delete that;
+  that->pool_.destroy(that);
 }
 
 
@@ -31,3 +32,10 @@ void simppl::dbus::detail::GetAllPropertiesHolder::pending_notify(DBusPendingCal
    auto cs = that->stub_.get_all_properties_handle_response(*msg, false);
    that->f_(cs);
 }
+
+
+/*static*/
+void simppl::dbus::detail::GetAllPropertiesHolder::eval_response(StubBase& stub, DBusMessage& msg)
+{
+   stub.get_all_properties_handle_response(msg, true);
+}
@@ -0,0 +1,214 @@
+#include "simppl/objectmanagerclient.h"
+
+#include "simppl/dispatcher.h"
+
+#include <cstring>
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+ObjectManagerClient::ObjectManagerClient(Dispatcher& disp, const char* busname, const char* objectpath)
+ : stub_(disp, busname, objectpath)
+ , synced_(false)
+{
+   match_ = std::string("type='signal',sender='") + busname
+      + "',interface='org.freedesktop.DBus.Properties',member='PropertiesChanged',path_namespace='" + objectpath + "'";
+
+   stub_.InterfacesAdded.attach() >> [this](const ObjectPath& path, const interfaces_type& ifaces){
+
+      auto& obj = objects_[path];
+
+      for (auto& iface : ifaces)
+         obj[iface.first] = iface.second;
+
+      if (added)
+         added(path);
+   };
+
+   stub_.InterfacesRemoved.attach() >> [this](const ObjectPath& path, const std::vector<std::string>& ifaces){
+
+      auto iter = objects_.find(path);
+
+      if (iter != objects_.end())
+      {
+         for (auto& iface : ifaces)
+            iter->second.erase(iface);
+
+         if (iter->second.empty())
+            objects_.erase(iter);
+
+         if (removed)
+            removed(path);
+      }
+   };
+
+   stub_.connected >> [this](ConnectionState state){
+      connection_state_changed(state);
+   };
+
+   disp.add_object_manager_client(*this, match_);
+}
+
+
+ObjectManagerClient::~ObjectManagerClient()
+{
+   owner_call_.cancel();
+   stub_.disp().remove_object_manager_client(*this, match_);
+}
+
+
+void ObjectManagerClient::connection_state_changed(ConnectionState state)
+{
+   if (state == ConnectionState::Connected)
+   {
+      // the bus answers before the service sees the GetManagedObjects
+      // request, so no signal reflected in the reply is missed
+      message_ptr_t msg = make_message(dbus_message_new_method_call(DBUS_SERVICE_DBUS, DBUS_PATH_DBUS, DBUS_INTERFACE_DBUS, "GetNameOwner"));
+
+      const char* busname = stub_.busname().c_str();
+      dbus_message_append_args(msg.get(), DBUS_TYPE_STRING, &busname, DBUS_TYPE_INVALID);
+
+      DBusPendingCall* pending = nullptr;
+      dbus_connection_send_with_reply(stub_.disp().conn_, msg.get(), &pending, DBUS_TIMEOUT_USE_DEFAULT);
+
+      owner_call_ = PendingCall(dbus_message_get_serial(msg.get()), pending);
+      dbus_pending_call_set_notify(pending, &ObjectManagerClient::owner_notify, this, nullptr);
+
+      // signals received before the reply are already reflected by it
+      stub_.GetManagedObjects.async() >> [this](const CallState& cs, const objects_type& objects){
+
+         if (cs)
+         {
+            objects_ = objects;
+            synced_ = true;
+
+            if (synced)
+               synced(ConnectionState::Connected);
+         }
+      };
+   }
+   else
+   {
+      owner_call_.cancel();
+      owner_.clear();
+
+      objects_.clear();
+      synced_ = false;
+
+      if (synced)
+         synced(state);
+   }
+}
+
+
+/*static*/
+void ObjectManagerClient::owner_notify(DBusPendingCall* pc, void* data)
+{
+   ObjectManagerClient* that = (ObjectManagerClient*)data;
+
+   message_ptr_t reply = make_message(dbus_pending_call_steal_reply(pc));
+   that->owner_call_.reset();
+
+   const char* owner = nullptr;
+
+   if (dbus_message_get_type(reply.get()) == DBUS_MESSAGE_TYPE_METHOD_RETURN
+      && dbus_message_get_args(reply.get(), nullptr, DBUS_TYPE_STRING, &owner, DBUS_TYPE_INVALID))
+      that->owner_ = owner;
+}
+
+
+bool ObjectManagerClient::try_handle_properties_changed(DBusMessage& msg)
+{
+   if (strcmp(dbus_message_get_interface(&msg), "org.freedesktop.DBus.Properties"))
+      return false;
+
+   // another service may export objects under the same path
+   const char* sender = dbus_message_get_sender(&msg);
+
+   if (owner_.empty() || !sender || owner_ != sender)
+      return false;
+
+   // only objects below the manager
+   const char* path = dbus_message_get_path(&msg);
+   const char* root = stub_.objectpath();
+   std::size_t len = strlen(root);
+
+   if (strncmp(path, root, len) || (len > 1 && path[len] != '\0' && path[len] != '/'))
+      return false;
+
+   auto obj = objects_.find(ObjectPath(path));
+
+   if (obj == objects_.end())
+      return false;
+
+   std::string iface_name;
+   properties_type values;
+   std::vector<std::string> invalidated;
+
+   try
+   {
+      DBusMessageIter iter;
+      dbus_message_iter_init(&msg, &iter);
+
+      decode(iter, iface_name, values, invalidated);
+   }
+   catch(DecoderError&)
+   {
+      return false;
+   }
+
+   auto iface = obj->second.find(iface_name);
+
+   if (iface == obj->second.end())
+      return false;
+
+   for (auto& value : values)
+      iface->second[value.first] = std::move(value.second);
+
+   for (auto& name : invalidated)
+      iface->second.erase(name);
+
+   if (changed)
+      changed(obj->first, iface->first);
+
+   return true;
+}
+
+
+const ObjectManagerClient::interfaces_type* ObjectManagerClient::find(const ObjectPath& path) const
+{
+   auto iter = objects_.find(path);
+   return iter == objects_.end() ? nullptr : &iter->second;
+}
+
+
+const ObjectManagerClient::properties_type* ObjectManagerClient::find(const ObjectPath& path, const std::string& iface) const
+{
+   if (auto obj = find(path))
+   {
+      auto iter = obj->find(iface);
+      return iter == obj->end() ? nullptr : &iter->second;
+   }
+
+   return nullptr;
+}
+
+
+const Any* ObjectManagerClient::find(const ObjectPath& path, const std::string& iface, const std::string& property) const
+{
+   if (auto props = find(path, iface))
+   {
+      auto iter = props->find(property);
+      return iter == props->end() ? nullptr : &iter->second;
+   }
+
+   return nullptr;
+}
+
+}   // namespace dbus
+
+}   // namespace simppl
@@ -1,36 +1,54 @@
 #include "simppl/objectmanagermixin.h"
 
 #include <cassert>
+#include <cstring>
 
 #include "simppl/serverside.h"
 #include "simppl/dispatcher.h"
 #include "simppl/objectpath.h"
+#include "simppl/string.h"
 
+#include "simppl/detail/wire.h"
 
-void simppl::dbus::ObjectManagerMixin::serialize_object(DBusMessageIter& _iter, const simppl::dbus::SkeletonBase& obj)
+
+namespace
+{
+
+/// simppl extension to page through the managed objects, see api/objectmanager.h
+const char* const paged_interface = "simppl.dbus.ext.ObjectManager";
+
+}   // namespace
+
+
+bool simppl::dbus::ObjectManagerMixin::serialize_object(DBusMessageIter& _iter, const simppl::dbus::SkeletonBase& obj)
 {
     DBusMessageIter iter[4];
+    bool cacheable = true;
 
     encode(_iter, simppl::dbus::ObjectPath(obj.objectpath()));
 
     // array of interfaces
     dbus_message_iter_open_container(&_iter, DBUS_TYPE_ARRAY, "{sa{sv}}", &iter[0]);
 
-    for(size_t i=0; i<obj.ifaces_.size(); ++i)
+    for (auto& iface : obj.table_->ifaces_)
     {
         dbus_message_iter_open_container(&iter[0], DBUS_TYPE_DICT_ENTRY, nullptr, &iter[1]);
-        encode(iter[1], obj.ifaces_[i]);
+        encode(iter[1], iface.name_);
 
         // array of properties
         dbus_message_iter_open_container(&iter[1], DBUS_TYPE_ARRAY, "{sv}", &iter[2]);
 
-        for (auto pp = obj.property_heads_[i]; pp; pp = pp->next_)
+        for (auto offset : iface.properties_)
         {
+            auto pp = obj.member<ServerPropertyBase>(offset);
+
             dbus_message_iter_open_container(&iter[2], DBUS_TYPE_DICT_ENTRY, nullptr, &iter[3]);
 
             encode(iter[3], pp->name_);
             pp->eval(&iter[3]);
 
+            cacheable &= pp->cacheable_;
+
             dbus_message_iter_close_container(&iter[2], &iter[3]);
         }
 
@@ -39,6 +57,36 @@ void simppl::dbus::ObjectManagerMixin::serialize_object(DBusMessageIter& _iter,
     }
 
     dbus_message_iter_close_container(&_iter, &iter[0]);
+
+    return cacheable;
+}
+
+
+const std::string& simppl::dbus::ObjectManagerMixin::fragment(ManagedObject& entry)
+{
+    unsigned int generation = entry.obj_->properties_generation();
+
+    if (!entry.cached_ || entry.generation_ != generation)
+    {
+        // marshal a reply with just this object, its dict entry is the fragment
+        message_ptr_t msg = make_message(dbus_message_new_signal("/", "org.freedesktop.DBus.ObjectManager", "GetManagedObjects"));
+
+        DBusMessageIter iter[3];
+        dbus_message_iter_init_append(msg.get(), &iter[0]);
+        dbus_message_iter_open_container(&iter[0], DBUS_TYPE_ARRAY, "{oa{sa{sv}}}", &iter[1]);
+        dbus_message_iter_open_container(&iter[1], DBUS_TYPE_DICT_ENTRY, nullptr, &iter[2]);
+
+        entry.cached_ = serialize_object(iter[2], *entry.obj_);
+
+        dbus_message_iter_close_container(&iter[1], &iter[2]);
+        dbus_message_iter_close_container(&iter[0], &iter[1]);
+
+        // skip the array length and the padding of the first element
+        entry.fragment_ = detail::wire_body(*msg).substr(8);
+        entry.generation_ = generation;
+    }
+
+    return entry.fragment_;
 }
 
 
@@ -46,16 +94,20 @@ void simppl::dbus::ObjectManagerMixin::add_managed_object(simppl::dbus::Skeleton
 {
     assert(obj);
 
-    objects_.insert(obj);
+    // keep the order of the signals
+    if (!changes_.empty())
+        flush();
 
-    message_ptr_t msg = make_message(dbus_message_new_signal(objectpath(), "org.freedesktop.DBus.ObjectManager", "InterfacesAdded"));
+    objects_.emplace(obj->objectpath(), ManagedObject{ obj, std::string(), 0, false });
 
-    DBusMessageIter iter;
-    dbus_message_iter_init_append(msg.get(), &iter);
+    send_interfaces_added(obj->objectpath());
+}
 
-    serialize_object(iter, *obj);
 
-    dbus_connection_send(disp_->conn_, msg.get(), nullptr);
+simppl::dbus::ObjectManagerMixin::~ObjectManagerMixin()
+{
+    if (flush_posted_)
+        flush();
 }
 
 
@@ -63,20 +115,116 @@ void simppl::dbus::ObjectManagerMixin::remove_managed_object(simppl::dbus::Skele
 {
     assert(obj);
 
-    objects_.erase(obj);
+    if (!changes_.empty())
+        flush();
+
+    objects_.erase(obj->objectpath());
+
+    send_interfaces_removed(obj->objectpath(), *obj->table_);
+}
+
+
+void simppl::dbus::ObjectManagerMixin::add_deferred(simppl::dbus::SkeletonBase* obj)
+{
+    assert(obj);
+
+    auto iter = objects_.emplace_hint(objects_.end(), obj->objectpath(), ManagedObject{ obj, std::string(), 0, false });
+    iter->second.obj_ = obj;
+
+    changes_[iter->first].added_ = true;
+}
+
+
+void simppl::dbus::ObjectManagerMixin::remove_deferred(simppl::dbus::SkeletonBase* obj)
+{
+    assert(obj);
+
+    auto iter = changes_.find(obj->objectpath());
+
+    if (iter == changes_.end())
+    {
+        // already announced
+        changes_[obj->objectpath()].removed_ = obj->table_;
+    }
+    else if (iter->second.added_)
+    {
+        // never announced
+        iter->second.added_ = false;
+
+        if (!iter->second.removed_)
+            changes_.erase(iter);
+    }
+
+    objects_.erase(obj->objectpath());
+}
+
 
+void simppl::dbus::ObjectManagerMixin::post_flush()
+{
+    if (!flush_posted_ && !changes_.empty())
+    {
+        flush_posted_ = true;
+
+        if (!self_)
+            self_ = std::make_shared<ObjectManagerMixin*>(this);
+
+        disp_->post([self = std::weak_ptr<ObjectManagerMixin*>(self_)](){
+            // the manager is destroyed already and flushed on destruction
+            if (auto that = self.lock())
+            {
+                (*that)->flush_posted_ = false;
+                (*that)->flush();
+            }
+        });
+    }
+}
+
+
+void simppl::dbus::ObjectManagerMixin::flush()
+{
+    for (auto& change : changes_)
+    {
+        if (change.second.removed_)
+            send_interfaces_removed(change.first.c_str(), *change.second.removed_);
+
+        if (change.second.added_)
+            send_interfaces_added(change.first);
+    }
+
+    changes_.clear();
+}
+
+
+void simppl::dbus::ObjectManagerMixin::send_interfaces_added(const std::string& path)
+{
+    auto object = objects_.find(path);
+    assert(object != objects_.end());
+
+    message_ptr_t msg = make_message(dbus_message_new_signal(objectpath(), "org.freedesktop.DBus.ObjectManager", "InterfacesAdded"));
+
+    DBusMessageIter iter;
+    dbus_message_iter_init_append(msg.get(), &iter);
+
+    serialize_object(iter, *object->second.obj_);
+
+    dbus_connection_send(disp_->conn_, msg.get(), nullptr);
+}
+
+
+void simppl::dbus::ObjectManagerMixin::send_interfaces_removed(const char* path, const detail::InterfaceTable& table)
+{
     message_ptr_t msg = make_message(dbus_message_new_signal(objectpath(), "org.freedesktop.DBus.ObjectManager", "InterfacesRemoved"));
 
     DBusMessageIter iter[2];
     dbus_message_iter_init_append(msg.get(), &iter[0]);
 
-    encode(iter[0], simppl::dbus::ObjectPath(obj->objectpath()));
+    encode(iter[0], simppl::dbus::ObjectPath(path));
 
     dbus_message_iter_open_container(&iter[0], DBUS_TYPE_ARRAY, "s", &iter[1]);
 
-    for(size_t i=0; i<obj->ifaces_.size(); ++i)
+    for (auto& iface : table.ifaces_)
     {
-        encode(iter[1], obj->ifaces_[i]);
+        encode(iter[1], iface.name_);
     }
 
     dbus_message_iter_close_container(&iter[0], &iter[1]);
@@ -87,24 +235,64 @@ void simppl::dbus::ObjectManagerMixin::remove_managed_object(simppl::dbus::Skele
 
 DBusHandlerResult simppl::dbus::ObjectManagerMixin::handle_objectmanager_request(DBusMessage* msg)
 {
-    message_ptr_t response = make_message(dbus_message_new_method_return(msg));
+    const char* method = dbus_message_get_member(msg);
 
-    DBusMessageIter iter[3];
+    if (strcmp(dbus_message_get_interface(msg), paged_interface) != 0)
+    {
+        if (strcmp(method, "GetManagedObjects") != 0)
+            return handle_error(msg, DBUS_ERROR_UNKNOWN_METHOD);
 
-    // array of object paths
-    dbus_message_iter_init_append(response.get(), &iter[0]);
-    dbus_message_iter_open_container(&iter[0], DBUS_TYPE_ARRAY, "{oa{sa{sv}}}", &iter[1]);
+        return send_managed_objects(msg, objects_.begin(), objects_.size());
+    }
+
+    if (strcmp(method, "GetManagedObjectsPaged") != 0)
+        return handle_error(msg, DBUS_ERROR_UNKNOWN_METHOD);
+
+    // the page starts after the last object path of the previous page
+    std::string after;
+    uint32_t max_count;
 
-    for (auto oiter = objects_.begin(); oiter != objects_.end(); ++oiter)
+    try
     {
-        dbus_message_iter_open_container(&iter[1], DBUS_TYPE_DICT_ENTRY, nullptr, &iter[2]);
+        DBusMessageIter iter;
+        dbus_message_iter_init(msg, &iter);
 
-        serialize_object(iter[2], *(*oiter));
+        decode(iter, after);
+        decode(iter, max_count);
+    }
+    catch(DecoderError&)
+    {
+        return handle_error(msg, DBUS_ERROR_INVALID_ARGS);
+    }
 
-        dbus_message_iter_close_container(&iter[1], &iter[2]);
+    return send_managed_objects(msg, objects_.upper_bound(after), max_count);
+}
+
+
+DBusHandlerResult simppl::dbus::ObjectManagerMixin::send_managed_objects(DBusMessage* msg, std::map<std::string, ManagedObject>::iterator first, std::size_t max_count)
+{
+    // the array length, padded to the 8 byte alignment of the dict entries
+    std::string body(8, '\0');
+
+    for (; first != objects_.end() && max_count > 0; ++first, --max_count)
+    {
+        body.resize((body.size() + 7) & ~std::size_t(7), '\0');
+        body += fragment(first->second);
     }
 
+    uint32_t len = body.size() - 8;
+    memcpy(&body[0], &len, sizeof(len));
+
+    // an empty reply of the right signature provides the header
+    message_ptr_t response = make_message(dbus_message_new_method_return(msg));
+
+    DBusMessageIter iter[2];
+    dbus_message_iter_init_append(response.get(), &iter[0]);
+    dbus_message_iter_open_container(&iter[0], DBUS_TYPE_ARRAY, "{oa{sa{sv}}}", &iter[1]);
     dbus_message_iter_close_container(&iter[0], &iter[1]);
+
+    response = detail::wire_message(*response, body.data(), body.size());
+
     dbus_connection_send(disp_->conn_, response.get(), nullptr);
 
     return DBUS_HANDLER_RESULT_HANDLED;
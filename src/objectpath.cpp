@@ -20,7 +20,7 @@ void ObjectPathCodec::encode(DBusMessageIter& iter, const ObjectPath& p)
 void ObjectPathCodec::decode(DBusMessageIter& iter, ObjectPath& p)
 {   
    char* c_str = nullptr;  
-   simppl_dbus_message_iter_get_basic(&iter, &c_str, DBUS_TYPE_OBJECT_PATH);
+   detail::iter_get_basic(&iter, &c_str, DBUS_TYPE_OBJECT_PATH);
    
    if (c_str)
    {
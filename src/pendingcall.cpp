@@ -12,41 +12,49 @@ namespace dbus
 
 PendingCall::PendingCall(uint32_t serial, DBusPendingCall* p)
  : serial_(serial)
+ , pending_(p)
 {
-	if (p)
-        pending_ = make_pending_call(p);
+	// NOOP
 }
 
 
 PendingCall::PendingCall()
  : serial_(SIMPPL_INVALID_SERIAL)
+ , pending_(nullptr)
 {
     // NOOP
 }
 
 
 PendingCall::PendingCall(PendingCall&& rhs)
+ : serial_(rhs.serial_)
+ , pending_(rhs.pending_)
 {
-	serial_ = rhs.serial_;
-    pending_ = rhs.pending_;
-
-    rhs.reset();
+    rhs.serial_ = SIMPPL_INVALID_SERIAL;
+    rhs.pending_ = nullptr;
 }
 
 
 PendingCall& PendingCall::operator=(PendingCall&& rhs)
 {
-	serial_ = rhs.serial_;
-    pending_ = rhs.pending_;
+    if (&rhs != this)
+    {
+        reset();
+
+        serial_ = rhs.serial_;
+        pending_ = rhs.pending_;
+
+        rhs.serial_ = SIMPPL_INVALID_SERIAL;
+        rhs.pending_ = nullptr;
+    }
 
-    rhs.reset();
     return *this;
 }
 
 
 PendingCall::PendingCall(const PendingCall& rhs)
  : serial_(rhs.serial_)
- , pending_(rhs.pending_)
+ , pending_(rhs.pending_ ? dbus_pending_call_ref(rhs.pending_) : nullptr)
 {
 	// NOOP
 }
@@ -56,13 +64,22 @@ PendingCall& PendingCall::operator=(const PendingCall& rhs)
 {
 	if (&rhs != this)
 	{
+		reset();
+
 		serial_ = rhs.serial_;
-		pending_ = rhs.pending_;
+		pending_ = rhs.pending_ ? dbus_pending_call_ref(rhs.pending_) : nullptr;
 	}
 	
 	return *this; 
 }
 
+
+PendingCall::~PendingCall()
+{
+    reset();
+}
+
+
 uint32_t PendingCall::serial() const
 {
     return serial_;
@@ -71,15 +88,14 @@ uint32_t PendingCall::serial() const
 
 DBusPendingCall* PendingCall::pending()
 {
-    DBusPendingCall* rc = pending_.get();
-    return rc;
+    return pending_;
 }
 
 
 void PendingCall::cancel()
 {
     if (pending_)
-		dbus_pending_call_cancel(pending_.get());
+		dbus_pending_call_cancel(pending_);
 	
 	reset();
 }
@@ -88,7 +104,12 @@ void PendingCall::cancel()
 void PendingCall::reset()
 {
     serial_ = SIMPPL_INVALID_SERIAL;
-    pending_.reset();
+
+    if (pending_)
+    {
+        dbus_pending_call_unref(pending_);
+        pending_ = nullptr;
+    }
 }
 
 
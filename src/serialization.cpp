@@ -1,20 +1,33 @@
 #include "simppl/serialization.h"
 
 
+namespace simppl
+{
+
+namespace dbus
+{
+
+namespace detail
+{
+
+__thread bool validated_decoding = false;
+
+}   // namespace detail
+
+}   // namespace dbus
+
+}   // namespace simppl
+
+
+// kept out-of-line for binaries built against former versions of the library
+
 void simppl_dbus_message_iter_recurse(DBusMessageIter* iter, DBusMessageIter* nested, int expected_type)
 {
-   if (dbus_message_iter_get_arg_type(iter) != expected_type)
-      throw simppl::dbus::DecoderError();
-      
-   dbus_message_iter_recurse(iter, nested);
+   simppl::dbus::detail::iter_recurse(iter, nested, expected_type);
 }
 
 
 void simppl_dbus_message_iter_get_basic(DBusMessageIter* iter, void* p, int expected_type)
 {
-   if (dbus_message_iter_get_arg_type(iter) != expected_type)
-      throw simppl::dbus::DecoderError();
-   
-   dbus_message_iter_get_basic(iter, p);
-   dbus_message_iter_next(iter);
+   simppl::dbus::detail::iter_get_basic(iter, p, expected_type);
 }
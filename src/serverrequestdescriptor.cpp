@@ -1,5 +1,6 @@
 #include "simppl/serverrequestdescriptor.h"
 
+#include "simppl/skeletonbase.h"
 #include "simppl/detail/constants.h"
 
 #include <dbus/dbus.h>
@@ -15,6 +16,8 @@ namespace dbus
 ServerRequestDescriptor::ServerRequestDescriptor()
  : requestor_(nullptr)
  , msg_(nullptr)
+ , skeleton_(nullptr)
+ , sequence_(0)
 {
    // NOOP
 }
@@ -23,9 +26,12 @@ ServerRequestDescriptor::ServerRequestDescriptor()
 ServerRequestDescriptor::ServerRequestDescriptor(ServerRequestDescriptor&& rhs)
  : requestor_(rhs.requestor_)
  , msg_(rhs.msg_)
+ , skeleton_(rhs.skeleton_)
+ , sequence_(rhs.sequence_)
 {
    rhs.requestor_ = nullptr;
    rhs.msg_ = nullptr;
+   rhs.skeleton_ = nullptr;
 }
 
 
@@ -39,11 +45,16 @@ ServerRequestDescriptor& ServerRequestDescriptor::operator=(ServerRequestDescrip
 {
    if (this != &rhs)
    {
+      clear();
+
       msg_ = rhs.msg_;
       requestor_ = rhs.requestor_;
+      skeleton_ = rhs.skeleton_;
+      sequence_ = rhs.sequence_;
       
       rhs.msg_ = nullptr;
       rhs.requestor_ = nullptr;
+      rhs.skeleton_ = nullptr;
    }
       
    return *this;
@@ -66,6 +77,13 @@ ServerRequestDescriptor& ServerRequestDescriptor::set(ServerMethodBase* requesto
 
 void ServerRequestDescriptor::clear()
 {
+   // dropped without response, don't stall the sender's later responses
+   if (skeleton_)
+   {
+      skeleton_->skip_response(*this);
+      skeleton_ = nullptr;
+   }
+
    if (msg_)
    {
       dbus_message_unref(msg_);
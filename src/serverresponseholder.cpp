@@ -1,5 +1,7 @@
 #include "simppl/detail/serverresponseholder.h"
 
+#include <cstring>
+
 
 namespace simppl
 {
@@ -10,17 +12,10 @@ namespace dbus
 namespace detail
 {
    
-ServerResponseHolder::ServerResponseHolder(std::function<void(DBusMessageIter&)> f)
- : f_(f)
-{
-   // NOOP
-}
-
-
 ServerResponseHolder::ServerResponseHolder(ServerResponseHolder&& rhs)
- : f_(std::move(rhs.f_))
+ : cb_(rhs.cb_)
 {
-   // NOOP
+   ::memcpy(storage_, rhs.storage_, sizeof(storage_));
 }
 
 
@@ -33,7 +28,10 @@ ServerResponseHolder::~ServerResponseHolder()
 ServerResponseHolder& ServerResponseHolder::operator=(ServerResponseHolder&& rhs)
 {
    if (this != &rhs)
-      f_ = rhs.f_;
+   {
+      cb_ = rhs.cb_;
+      ::memcpy(storage_, rhs.storage_, sizeof(storage_));
+   }
    
    return *this;
 }
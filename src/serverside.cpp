@@ -14,10 +14,10 @@ namespace dbus
  
 ServerMethodBase::ServerMethodBase(const char* name, SkeletonBase* iface, int iface_id)
  : name_(name)
+ , executor_(nullptr)
+ , parent_(iface)
 {
-   auto& methods = iface->method_heads_[iface_id];
-   this->next_ = methods;
-   methods = this;
+   iface->add_member(this, iface_id);
 }
 
 
@@ -48,10 +48,15 @@ ServerPropertyBase::ServerPropertyBase(const char* name, SkeletonBase* iface, in
  : name_(name)
  , iface_id_(iface_id)
  , parent_(iface)
+ , cacheable_(true)
+{
+   iface->add_member(this, iface_id);
+}
+
+
+void ServerPropertyBase::changed()
 {
-   auto& properties = iface->property_heads_[iface_id];
-   this->next_ = properties;
-   properties = this;
+   parent_->property_changed(iface_id_);
 }
 
 
@@ -61,9 +66,7 @@ ServerSignalBase::ServerSignalBase(const char* name, SkeletonBase* iface, int if
  , parent_(iface)
 {
 #if SIMPPL_HAVE_INTROSPECTION
-   auto& signals = iface->signal_heads_[iface_id];
-   this->next_ = signals;
-   signals = this;
+   iface->add_member(this, iface_id);
 #endif
 }
  
@@ -0,0 +1,138 @@
+#include "simppl/shardeddispatcher.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+
+ShardedDispatcher::ShardedDispatcher(std::size_t shards, const char* busname)
+ : running_(false)
+{
+   // the connections are used from different threads
+   enable_threads();
+
+   if (shards == 0)
+      shards = std::max(1u, std::thread::hardware_concurrency());
+
+   shards_.reserve(shards);
+
+   for (std::size_t i = 0; i < shards; ++i)
+      shards_.emplace_back(new Dispatcher(busname));
+}
+
+
+ShardedDispatcher::~ShardedDispatcher()
+{
+   // NOOP
+}
+
+
+std::size_t ShardedDispatcher::index_for(const std::string& objectpath) const
+{
+   return std::hash<std::string>()(objectpath) % shards_.size();
+}
+
+
+Dispatcher& ShardedDispatcher::shard_for(const std::string& busname, const std::string& objectpath)
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+
+   auto iter = busnames_.find(busname);
+
+   if (iter == busnames_.end())
+      iter = busnames_.emplace(busname, index_for(objectpath)).first;
+
+   return *shards_[iter->second];
+}
+
+
+Dispatcher& ShardedDispatcher::shard_for(const std::string& objectpath)
+{
+   return *shards_[index_for(objectpath)];
+}
+
+
+void ShardedDispatcher::run_shard(Dispatcher& shard)
+{
+   try
+   {
+      shard.init();
+
+      // don't use Dispatcher::run(), a stop() issued before the
+      // shard's loop is started must not get lost
+      while(running_.load())
+         shard.step(std::chrono::milliseconds(-1));
+   }
+   catch(...)
+   {
+      {
+         std::lock_guard<std::mutex> lock(mutex_);
+
+         if (!error_)
+            error_ = std::current_exception();
+      }
+
+      stop();
+   }
+}
+
+
+int ShardedDispatcher::run()
+{
+   running_.store(true);
+
+   std::vector<std::thread> threads;
+   threads.reserve(shards_.size() - 1);
+
+   for (std::size_t i = 1; i < shards_.size(); ++i)
+      threads.emplace_back([this, i](){ run_shard(*shards_[i]); });
+
+   // the calling thread runs the first shard
+   run_shard(*shards_[0]);
+
+   for (auto& t : threads)
+      t.join();
+
+   if (error_)
+   {
+      std::exception_ptr error;
+      std::swap(error, error_);
+
+      std::rethrow_exception(error);
+   }
+
+   return 0;
+}
+
+
+void ShardedDispatcher::stop()
+{
+   running_.store(false);
+
+   // wake up all loops
+   for (auto& shard : shards_)
+      shard->stop();
+}
+
+
+Dispatcher::Statistics ShardedDispatcher::statistics() const
+{
+   Dispatcher::Statistics stats;
+
+   for (auto& shard : shards_)
+      stats += shard->statistics();
+
+   return stats;
+}
+
+
+}   // namespace dbus
+
+}   // namespace simppl
@@ -1,6 +1,7 @@
 #include "simppl/skeletonbase.h"
 
 #include "simppl/dispatcher.h"
+#include "simppl/threadpool.h"
 #include "simppl/interface.h"
 #include "simppl/string.h"
 #include "simppl/vector.h"
@@ -15,8 +16,14 @@
 #include <cxxabi.h>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
 
 
 namespace simppl
@@ -33,6 +40,196 @@ using DemangledNamePtr = std::unique_ptr<char, FreeDeleter>;
 } // namespace detail
 
 
+namespace
+{
+
+/// requests handled on pool threads
+__thread SkeletonBase* current_skeleton = nullptr;
+__thread ServerRequestDescriptor* current_pool_request = nullptr;
+
+
+/// for skeletons without interfaces
+const detail::InterfaceTable empty_table;
+
+
+/// the interface tables by skeleton type key, see SkeletonBase::init_table()
+struct InterfaceTables
+{
+    std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<detail::InterfaceTable>> tables_;
+};
+
+
+InterfaceTables& interface_tables()
+{
+    static InterfaceTables tables;
+    return tables;
+}
+
+
+/// interfaces implemented by the skeleton itself, see handle_request()
+bool is_builtin_interface(const char* name)
+{
+#if SIMPPL_HAVE_INTROSPECTION
+    if (!strcmp(name, "org.freedesktop.DBus.Introspectable"))
+        return true;
+#endif
+
+#if SIMPPL_HAVE_OBJECTMANAGER
+    if (!strcmp(name, "org.freedesktop.DBus.ObjectManager"))
+        return true;
+#endif
+
+    return !strcmp(name, "org.freedesktop.DBus.Properties");
+}
+
+
+#if SIMPPL_HAVE_INTROSPECTION
+const char* const introspectable_xml =
+    "  <interface name=\"org.freedesktop.DBus.Introspectable\">\n"
+    "    <method name=\"Introspect\">\n"
+    "      <arg name=\"data\" type=\"s\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "  </interface>\n";
+
+const char* const properties_xml =
+    "  <interface name=\"org.freedesktop.DBus.Properties\">\n"
+    "    <method name=\"Get\">\n"
+    "      <arg name=\"interface_name\" type=\"s\" direction=\"in\"/>\n"
+    "      <arg name=\"property_name\" type=\"s\" direction=\"in\"/>\n"
+    "      <arg name=\"value\" type=\"v\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <method name=\"Set\">\n"
+    "      <arg name=\"interface_name\" type=\"s\" direction=\"in\"/>\n"
+    "      <arg name=\"property_name\" type=\"s\" direction=\"in\"/>\n"
+    "      <arg name=\"value\" type=\"v\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"GetAll\">\n"
+    "      <arg name=\"interface_name\" type=\"s\" direction=\"in\"/>\n"
+    "      <arg name=\"properties\" type=\"a{sv}\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <signal name=\"PropertiesChanged\">\n"
+    "      <arg name=\"interface_name\" type=\"s\"/>\n"
+    "      <arg name=\"changed_properties\" type=\"a{sv}\"/>\n"
+    "      <arg name=\"invalidated_properties\" type=\"as\"/>\n"
+    "    </signal>\n"
+    "  </interface>\n";
+#endif
+
+}   // namespace
+
+
+/**
+ * Keeps the responses per sender in the order the requests were received.
+ * Only used from the dispatcher thread.
+ */
+struct SkeletonBase::ResponseSequencer
+{
+    struct Queue
+    {
+        uint32_t next_sequence_ = 0;
+        uint32_t next_response_ = 0;
+
+        /// finished responses waiting for earlier ones, nullptr if skipped
+        std::map<uint32_t, std::shared_ptr<DBusMessage>> done_;
+    };
+
+    uint32_t enqueue(const char* sender)
+    {
+        return queues_[sender].next_sequence_++;
+    }
+
+    void complete(DBusConnection* conn, const std::string& sender, uint32_t sequence, std::shared_ptr<DBusMessage> msg)
+    {
+        auto iter = queues_.find(sender);
+        assert(iter != queues_.end());
+
+        auto& q = iter->second;
+        q.done_.emplace(sequence, std::move(msg));
+
+        while(!q.done_.empty() && q.done_.begin()->first == q.next_response_)
+        {
+            if (q.done_.begin()->second)
+                dbus_connection_send(conn, q.done_.begin()->second.get(), nullptr);
+
+            q.done_.erase(q.done_.begin());
+            ++q.next_response_;
+        }
+
+        // all requests answered
+        if (q.done_.empty() && q.next_response_ == q.next_sequence_)
+            queues_.erase(iter);
+    }
+
+    std::unordered_map<std::string, Queue> queues_;
+};
+
+
+/**
+ * Liveness of the skeleton for the handlers posted to thread pools, which
+ * may still be queued when the skeleton is destroyed.
+ */
+struct SkeletonBase::PendingHandlers
+{
+    std::mutex mutex_;
+    std::condition_variable cond_;
+
+    bool alive_ = true;
+    unsigned int running_ = 0;
+};
+
+
+/**
+ * The thread pool state of a skeleton, allocated once a pool is used
+ * either by the skeleton or by one of its methods.
+ */
+struct SkeletonBase::Executor
+{
+    ThreadPool* pool_ = nullptr;
+
+    std::shared_ptr<ResponseSequencer> sequencer_;   ///< only set for ordered responses
+    std::shared_ptr<PendingHandlers> pending_ = std::make_shared<PendingHandlers>();
+};
+
+
+/**
+ * The members of the first skeleton of a type in order of construction,
+ * as (interface id, offset) pairs.
+ */
+struct SkeletonBase::TableBuilder
+{
+    std::vector<std::pair<int, std::ptrdiff_t>> methods_;
+    std::vector<std::pair<int, std::ptrdiff_t>> properties_;
+    std::vector<std::pair<int, std::ptrdiff_t>> signals_;
+};
+
+
+#if SIMPPL_HAVE_INTROSPECTION
+/// cached Introspect reply, the child nodes are appended at the end
+struct SkeletonBase::IntrospectionCache
+{
+    std::string xml_;
+    size_type children_ = 0;
+    unsigned int registrations_ = 0;   ///< Dispatcher::registrations() the children reflect
+};
+#endif
+
+
+/**
+ * The last GetAll reply of an interface. Any property change bumps the
+ * generation, the reply is rebuilt on the next GetAll request then.
+ * Properties may be changed from any thread, GetAll is only handled on
+ * the dispatcher thread.
+ */
+struct SkeletonBase::PropertyCache
+{
+    std::atomic<unsigned int> generation_{0};
+    unsigned int built_ = 0;   ///< generation the reply was built from
+
+    message_ptr_t reply_ = make_message(nullptr);
+};
+
+
 /*static*/
 DBusHandlerResult SkeletonBase::method_handler(DBusConnection* connection, DBusMessage* msg, void *user_data)
 {
@@ -41,19 +238,29 @@ DBusHandlerResult SkeletonBase::method_handler(DBusConnection* connection, DBusM
 }
 
 
-SkeletonBase::SkeletonBase(std::size_t iface_count)
-  : ifaces_(iface_count, std::string())
+SkeletonBase::SkeletonBase(std::size_t /*iface_count*/)
+  : table_(&empty_table)
   , disp_(nullptr)
-  , method_heads_(iface_count, nullptr)
-  , property_heads_(iface_count, nullptr)
-#if SIMPPL_HAVE_INTROSPECTION
-  , signal_heads_(iface_count, nullptr)
-#endif
 {}
 
 
+SkeletonBase::SkeletonBase(std::size_t iface_count, const char* key)
+  : SkeletonBase(iface_count)
+{
+    auto& tables = interface_tables();
+    std::lock_guard<std::mutex> lock(tables.mutex_);
+
+    auto iter = tables.tables_.find(key);
+
+    if (iter != tables.tables_.end())
+        table_ = iter->second.get();
+}
+
+
 SkeletonBase::~SkeletonBase()
 {
+   drain_executor();
+
    if (disp_)
       disp_->remove_server(*this);
 }
@@ -63,11 +270,10 @@ void SkeletonBase::init(const char* mangled_iface_list, const char* role)
 {
     assert(role);
 
-    detail::DemangledNamePtr iface(abi::__cxa_demangle(mangled_iface_list, 0, 0, 0));
-    ifaces_ = detail::extract_interfaces(1, iface.get());
+    init(1, mangled_iface_list);
 
-    objectpath_ = detail::create_objectpath(ifaces_[0].c_str(), role);
-    busname_ = detail::create_busname(ifaces_[0].c_str(), role);
+    objectpath_ = detail::create_objectpath(iface(0).c_str(), role);
+    busname_ = detail::create_busname(iface(0).c_str(), role);
 }
 
 
@@ -76,13 +282,23 @@ void SkeletonBase::init(size_type iface_count, const char* mangled_iface_list, s
     assert(busname.length() > 0);
     assert(objectpath.length() > 0);
 
-    detail::DemangledNamePtr iface(abi::__cxa_demangle(mangled_iface_list, 0, 0, 0));
-    ifaces_ = detail::extract_interfaces(iface_count, iface.get());
+    init(iface_count, mangled_iface_list);
+
     busname_ = std::move(busname);
     objectpath_ = std::move(objectpath);
 }
 
 
+void SkeletonBase::init(size_type iface_count, const char* mangled_iface_list)
+{
+    // the interface list identifies the skeleton type
+    init_table(mangled_iface_list, [iface_count, mangled_iface_list](){
+        detail::DemangledNamePtr iface(abi::__cxa_demangle(mangled_iface_list, 0, 0, 0));
+        return detail::extract_interfaces(iface_count, iface.get());
+    });
+}
+
+
 void SkeletonBase::init(std::string busname, std::string objectpath)
 {
     assert(busname.length() > 0);
@@ -93,6 +309,128 @@ void SkeletonBase::init(std::string busname, std::string objectpath)
 }
 
 
+void SkeletonBase::init_table(const std::string& key, const std::vector<std::string>& ifaces)
+{
+    init_table(key, [&ifaces](){ return ifaces; });
+}
+
+
+void SkeletonBase::init_table(const std::string& key, detail::function_ref<std::vector<std::string>()> ifaces)
+{
+    // already attached on construction
+    if (table_ == &empty_table)
+    {
+        auto& tables = interface_tables();
+        std::lock_guard<std::mutex> lock(tables.mutex_);
+
+        auto& table = tables.tables_[key];
+
+        if (!table)
+        {
+            table.reset(new detail::InterfaceTable);
+
+            std::vector<std::string> names = ifaces();
+            table->ifaces_.resize(names.size());
+
+            // `names[0]` has the highest ID (e.g. N-1), so we need to
+            // "reverse" the order.
+            for (size_type i = 0; i < names.size(); ++i)
+            {
+                // use c_str() because the names may contain trailing zeros
+                table->ifaces_[names.size() - i - 1].name_ = names[i].c_str();
+            }
+
+            if (builder_)
+            {
+                // reverse order of construction
+                for (auto pm = builder_->methods_.rbegin(); pm != builder_->methods_.rend(); ++pm)
+                    table->ifaces_[pm->first].methods_.push_back(pm->second);
+
+                for (auto pp = builder_->properties_.rbegin(); pp != builder_->properties_.rend(); ++pp)
+                {
+                    table->ifaces_[pp->first].properties_.push_back(pp->second);
+                    table->has_properties_ = true;
+                }
+
+                for (auto ps = builder_->signals_.rbegin(); ps != builder_->signals_.rend(); ++ps)
+                    table->ifaces_[ps->first].signals_.push_back(ps->second);
+            }
+
+            for (size_type id = 0; id < table->ifaces_.size(); ++id)
+            {
+                auto& iface = table->ifaces_[id];
+                const char* name = iface.name_.c_str();
+
+                table->index_.insert(detail::DispatchIndex::Interface, name, "", id, 0);
+
+                if (!is_builtin_interface(name))
+                {
+                    for (auto offset : iface.methods_)
+                        table->index_.insert(detail::DispatchIndex::Method, name, member<ServerMethodBase>(offset)->name_, id, offset);
+                }
+
+                for (auto offset : iface.properties_)
+                    table->index_.insert(detail::DispatchIndex::Property, name, member<ServerPropertyBase>(offset)->name_, id, offset);
+            }
+
+#if SIMPPL_HAVE_INTROSPECTION
+            std::ostringstream oss;
+
+            for (size_type id = 0; id < table->ifaces_.size(); ++id)
+                introspect_interface(oss, *table, id);
+
+            table->introspection_ = oss.str();
+#endif
+        }
+
+        table_ = table.get();
+    }
+
+    builder_.reset();
+
+    if (table_->has_properties_)
+        property_cache_.reset(new PropertyCache[table_->ifaces_.size()]);
+}
+
+
+void SkeletonBase::add_member(ServerMethodBase* method, int iface_id)
+{
+    if (table_ == &empty_table)
+    {
+        if (!builder_)
+            builder_.reset(new TableBuilder);
+
+        builder_->methods_.emplace_back(iface_id, (char*)method - (char*)this);
+    }
+}
+
+
+void SkeletonBase::add_member(ServerPropertyBase* property, int iface_id)
+{
+    if (table_ == &empty_table)
+    {
+        if (!builder_)
+            builder_.reset(new TableBuilder);
+
+        builder_->properties_.emplace_back(iface_id, (char*)property - (char*)this);
+    }
+}
+
+
+#if SIMPPL_HAVE_INTROSPECTION
+void SkeletonBase::add_member(ServerSignalBase* signal, int iface_id)
+{
+    if (table_ == &empty_table)
+    {
+        if (!builder_)
+            builder_.reset(new TableBuilder);
+
+        builder_->signals_.emplace_back(iface_id, (char*)signal - (char*)this);
+    }
+}
+#endif
+
+
 Dispatcher& SkeletonBase::disp()
 {
    assert(disp_);
@@ -102,31 +440,18 @@ Dispatcher& SkeletonBase::disp()
 
 ServerRequestDescriptor SkeletonBase::defer_response()
 {
-   assert(current_request_);
-  // assert(current_request_.requestor_->hasResponse());
+   assert(request());
+  // assert(request().requestor_->hasResponse());
 
-   return std::move(current_request_);
+   return std::move(request());
 }
 
 
 void SkeletonBase::respond_with(detail::ServerResponseHolder response)
 {
-   assert(current_request_);
-   //assert(response.responder_->allowedRequests_.find(current_request_.requestor_) != response.responder_->allowedRequests_.end());
-
-   message_ptr_t rmsg = make_message(dbus_message_new_method_return(current_request_.msg_));
+   assert(request());
 
-   if (response.f_)
-   {
-      DBusMessageIter iter;
-      dbus_message_iter_init_append(rmsg.get(), &iter);
-
-      response.f_(iter);
-   }
-
-   dbus_connection_send(disp_->conn_, rmsg.get(), nullptr);
-
-   current_request_.clear();   // only respond once!!!
+   respond_on(request(), std::move(response));   // only respond once!!!
 }
 
 
@@ -137,29 +462,18 @@ void SkeletonBase::respond_on(ServerRequestDescriptor& req, detail::ServerRespon
 
    message_ptr_t rmsg = make_message(dbus_message_new_method_return(req.msg_));
 
-   if (response.f_)
-   {
-      DBusMessageIter iter;
-      dbus_message_iter_init_append(rmsg.get(), &iter);
-
-      response.f_(iter);
-   }
+   if (response)
+      response(rmsg);
 
-   dbus_connection_send(disp_->conn_, rmsg.get(), nullptr);
-
-   req.clear();
+   send_response(req, std::move(rmsg));
 }
 
 
 void SkeletonBase::respond_with(const Error& err)
 {
-   assert(current_request_);
-   //assert(current_request_.requestor_->hasResponse());
-
-   message_ptr_t rmsg = current_request_.requestor_->_throw(*current_request_.msg_, err);
-   dbus_connection_send(disp_->conn_, rmsg.get(), nullptr);
+   assert(request());
 
-   current_request_.clear();   // only respond once!!!
+   respond_on(request(), err);   // only respond once!!!
 }
 
 
@@ -168,17 +482,103 @@ void SkeletonBase::respond_on(ServerRequestDescriptor& req, const Error& err)
    assert(req);
    //assert(req.requestor_->hasResponse());
 
-   message_ptr_t rmsg = req.requestor_->_throw(*req.msg_, err);
-   dbus_connection_send(disp_->conn_, rmsg.get(), nullptr);
+   send_response(req, req.requestor_->_throw(*req.msg_, err));
+}
+
+
+const ServerRequestDescriptor& SkeletonBase::current_request() const
+{
+   assert(request());
+   return request();
+}
+
+
+ServerRequestDescriptor& SkeletonBase::request()
+{
+   return current_skeleton == this ? *current_pool_request : current_request_;
+}
+
+
+const ServerRequestDescriptor& SkeletonBase::request() const
+{
+   return current_skeleton == this ? *current_pool_request : current_request_;
+}
+
+
+void SkeletonBase::set_executor(ThreadPool* pool, bool ordered)
+{
+   if (!executor_)
+      executor_.reset(new Executor);
+
+   executor_->pool_ = pool;
+
+   if (ordered)
+   {
+      if (!executor_->sequencer_)
+         executor_->sequencer_.reset(new ResponseSequencer);
+   }
+   else
+      executor_->sequencer_.reset();
+}
+
+
+void SkeletonBase::drain_executor()
+{
+   assert(current_skeleton != this);
+
+   if (executor_)
+   {
+      auto& pending = *executor_->pending_;
+      std::unique_lock<std::mutex> lock(pending.mutex_);
+
+      pending.alive_ = false;
+      pending.cond_.wait(lock, [&pending](){ return pending.running_ == 0; });
+   }
+}
+
+
+void SkeletonBase::send(message_ptr_t msg)
+{
+   if (ThreadPool::current())
+   {
+      std::shared_ptr<DBusMessage> m(msg.release(), &dbus_message_unref);
+
+      disp_->post([conn = disp_->conn_, m](){
+         dbus_connection_send(conn, m.get(), nullptr);
+      });
+   }
+   else
+      dbus_connection_send(disp_->conn_, msg.get(), nullptr);
+}
+
+
+void SkeletonBase::send_response(ServerRequestDescriptor& req, message_ptr_t msg)
+{
+   if (req.skeleton_)
+   {
+      std::shared_ptr<DBusMessage> m(msg.release(), &dbus_message_unref);
+
+      // no this, the skeleton may be gone until the task is run
+      disp_->post([conn = disp_->conn_, seq = executor_->sequencer_, sender = std::string(dbus_message_get_sender(req.msg_)), sequence = req.sequence_, m](){
+         if (seq)
+            seq->complete(conn, sender, sequence, m);
+      });
+
+      req.skeleton_ = nullptr;
+   }
+   else
+      send(std::move(msg));
 
    req.clear();
 }
 
 
-const ServerRequestDescriptor& SkeletonBase::current_request() const
+void SkeletonBase::skip_response(ServerRequestDescriptor& req)
 {
-   assert(current_request_);
-   return current_request_;
+   disp_->post([conn = disp_->conn_, seq = executor_->sequencer_, sender = std::string(dbus_message_get_sender(req.msg_)), sequence = req.sequence_](){
+      if (seq)
+         seq->complete(conn, sender, sequence, nullptr);
+   });
 }
 
 
@@ -193,13 +593,17 @@ DBusHandlerResult SkeletonBase::handle_request(DBusMessage* msg)
     const char* method_name = dbus_message_get_member(msg);
     const char* interface_name = dbus_message_get_interface(msg);
 
+    // hot path: a method of one of the implemented interfaces
+    if (auto e = table_->index_.find(detail::DispatchIndex::Method, interface_name, method_name))
+        return handle_interface_request(msg, *member<ServerMethodBase>(e->offset_));
+
 #if SIMPPL_HAVE_INTROSPECTION
     if (!strcmp(interface_name, "org.freedesktop.DBus.Introspectable"))
         return handle_introspect_request(msg);
 #endif
 
 #if SIMPPL_HAVE_OBJECTMANAGER
-    if (!strcmp(interface_name, "org.freedesktop.DBus.ObjectManager"))
+    if (!strcmp(interface_name, "org.freedesktop.DBus.ObjectManager") || !strcmp(interface_name, "simppl.dbus.ext.ObjectManager"))
         return handle_objectmanager_request(msg);
 #endif
 
@@ -211,15 +615,10 @@ DBusHandlerResult SkeletonBase::handle_request(DBusMessage* msg)
         return handle_property_request(msg);
     }
 
-    int iface_id = find_interface(interface_name);
-    if (iface_id == invalid_iface_id)
+    if (find_interface(interface_name) == invalid_iface_id)
         return handle_error(msg, DBUS_ERROR_UNKNOWN_INTERFACE);
 
-    ServerMethodBase* method = find_method(iface_id, method_name);
-    if (!method)
-        return handle_error(msg, DBUS_ERROR_UNKNOWN_METHOD);
-
-    return handle_interface_request(msg, *method);
+    return handle_error(msg, DBUS_ERROR_UNKNOWN_METHOD);
 }
 
 
@@ -231,76 +630,62 @@ DBusHandlerResult SkeletonBase::handle_introspect_request(DBusMessage* msg)
     if (strcmp(method, "Introspect") != 0)
         return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
 
-    std::ostringstream oss;
+    unsigned int registrations = disp_->registrations();
+    bool refresh = introspection_ && registrations != introspection_->registrations_;
 
-    oss << "<?xml version=\"1.0\" ?>\n"
-           "<node name=\""<< objectpath() << "\">\n";
-
-    for (size_type i = 0; i < ifaces_.size(); ++i)
+    // the interfaces never change, only the children do
+    if (!introspection_)
     {
-        introspect_interface(oss, i);
-    }
+        introspection_.reset(new IntrospectionCache);
 
-    // introspectable
-    oss << "  <interface name=\"org.freedesktop.DBus.Introspectable\">\n"
-           "    <method name=\"Introspect\">\n"
-           "      <arg name=\"data\" type=\"s\" direction=\"out\"/>\n"
-           "    </method>\n"
-           "  </interface>\n";
+        std::string& xml = introspection_->xml_;
+        xml = "<?xml version=\"1.0\" ?>\n<node name=\"";
+        xml += objectpath();
+        xml += "\">\n";
+        xml += table_->introspection_;
+        xml += introspectable_xml;
 
-    // properties
-    if (has_any_properties())
-    {
-        oss << "  <interface name=\"org.freedesktop.DBus.Properties\">\n"
-               "    <method name=\"Get\">\n"
-               "      <arg name=\"interface_name\" type=\"s\" direction=\"in\"/>\n"
-               "      <arg name=\"property_name\" type=\"s\" direction=\"in\"/>\n"
-               "      <arg name=\"value\" type=\"v\" direction=\"out\"/>\n"
-               "    </method>\n"
-               "    <method name=\"Set\">\n"
-               "      <arg name=\"interface_name\" type=\"s\" direction=\"in\"/>\n"
-               "      <arg name=\"property_name\" type=\"s\" direction=\"in\"/>\n"
-               "      <arg name=\"value\" type=\"v\" direction=\"in\"/>\n"
-               "    </method>\n"
-               "    <method name=\"GetAll\">\n"
-               "      <arg name=\"interface_name\" type=\"s\" direction=\"in\"/>\n"
-               "      <arg name=\"properties\" type=\"a{sv}\" direction=\"out\"/>\n"
-               "    </method>\n"
-               "    <signal name=\"PropertiesChanged\">\n"
-               "      <arg name=\"interface_name\" type=\"s\"/>\n"
-               "      <arg name=\"changed_properties\" type=\"a{sv}\"/>\n"
-               "      <arg name=\"invalidated_properties\" type=\"as\"/>\n"
-               "    </signal>\n"
-               "  </interface>\n";
+        if (has_any_properties())
+            xml += properties_xml;
+
+        introspection_->children_ = xml.size();
+        refresh = true;
     }
 
-    // recurse into any objects below this path
-    char** children = nullptr;
-    dbus_connection_list_registered(disp_->conn_, objectpath(), &children);
+    std::string& xml = introspection_->xml_;
 
-    if (children)
+    if (refresh)
     {
-        char** child = children;
+        xml.resize(introspection_->children_);
+
+        // recurse into any objects below this path
+        char** children = nullptr;
+        dbus_connection_list_registered(disp_->conn_, objectpath(), &children);
 
-        while(*child != nullptr)
+        if (children)
         {
-            oss << "<node name=\"" << *child << "\"/>\n";
-            ++child;
+            for (char** child = children; *child != nullptr; ++child)
+            {
+                xml += "<node name=\"";
+                xml += *child;
+                xml += "\"/>\n";
+            }
+
+            dbus_free_string_array(children);
         }
 
-        dbus_free_string_array(children);
+        xml += "</node>\n";
+        introspection_->registrations_ = registrations;
     }
 
-    oss << "</node>\n";
-
-    DBusMessage* reply = dbus_message_new_method_return(msg);
+    message_ptr_t reply = make_message(dbus_message_new_method_return(msg));
 
     DBusMessageIter iter;
-    dbus_message_iter_init_append(reply, &iter);
+    dbus_message_iter_init_append(reply.get(), &iter);
 
-    encode(iter, oss.str());
+    encode(iter, xml);
 
-    dbus_connection_send(disp_->conn_, reply, nullptr);
+    dbus_connection_send(disp_->conn_, reply.get(), nullptr);
     return DBUS_HANDLER_RESULT_HANDLED;
 }
 #endif  // defined(SIMPPL_HAVE_INTROSPECTION)
@@ -308,7 +693,23 @@ DBusHandlerResult SkeletonBase::handle_introspect_request(DBusMessage* msg)
 
 DBusHandlerResult SkeletonBase::handle_property_getall_request(DBusMessage* msg, int iface_id)
 {
+    auto& cache = property_cache_[iface_id];
+    unsigned int generation = cache.generation_;
+
+    if (cache.reply_ && cache.built_ == generation)
+    {
+        // the copy has no serial yet, just readdress it
+        message_ptr_t response = make_message(dbus_message_copy(cache.reply_.get()));
+
+        dbus_message_set_reply_serial(response.get(), dbus_message_get_serial(msg));
+        dbus_message_set_destination(response.get(), dbus_message_get_sender(msg));
+
+        dbus_connection_send(disp_->conn_, response.get(), nullptr);
+        return DBUS_HANDLER_RESULT_HANDLED;
+    }
+
     message_ptr_t response = make_message(dbus_message_new_method_return(msg));
+    bool cacheable = true;
 
     DBusMessageIter iter;
     DBusMessageIter _iter;
@@ -317,19 +718,32 @@ DBusHandlerResult SkeletonBase::handle_property_getall_request(DBusMessage* msg,
     dbus_message_iter_init_append(response.get(), &iter);
     dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, "{sv}", &_iter);
 
-    for (auto pp = property_heads_[iface_id]; pp; pp = pp->next_)
+    for (auto offset : table_->ifaces_[iface_id].properties_)
     {
+        auto pp = member<ServerPropertyBase>(offset);
+
         dbus_message_iter_open_container(&_iter, DBUS_TYPE_DICT_ENTRY, nullptr, &__iter);
 
         encode(__iter, pp->name_);
         pp->eval(&__iter);
 
+        cacheable &= pp->cacheable_;
+
         dbus_message_iter_close_container(&_iter, &__iter);
     }
 
     dbus_message_iter_close_container(&iter, &_iter);
 
     dbus_connection_send(disp_->conn_, response.get(), nullptr);
+
+    if (cacheable)
+    {
+        cache.reply_ = std::move(response);
+        cache.built_ = generation;
+    }
+    else
+        cache.reply_.reset();
+
     return DBUS_HANDLER_RESULT_HANDLED;
 }
 
@@ -445,34 +859,97 @@ DBusHandlerResult SkeletonBase::handle_property_set_request(DBusMessage* msg, Se
 
 DBusHandlerResult SkeletonBase::handle_interface_request(DBusMessage* msg, ServerMethodBase& method)
 {
-    current_request_.set(&method, msg);
+    ThreadPool* pool = method.executor_ ? method.executor_ : executor_ ? executor_->pool_ : nullptr;
+
+    ServerRequestDescriptor req;
+    req.set(&method, msg);
+
+    if (executor_ && executor_->sequencer_ && !dbus_message_get_no_reply(msg))
+    {
+        req.skeleton_ = this;
+        req.sequence_ = executor_->sequencer_->enqueue(dbus_message_get_sender(msg));
+    }
+
+    if (pool)
+    {
+        // std::function needs a copyable functor
+        auto preq = std::make_shared<ServerRequestDescriptor>(std::move(req));
+
+        if (!executor_)
+            executor_.reset(new Executor);
+
+        pool->post([this, pending = executor_->pending_, preq](){
+            {
+                std::lock_guard<std::mutex> lock(pending->mutex_);
+
+                // the skeleton is already destroyed
+                if (!pending->alive_)
+                    return;
+
+                ++pending->running_;
+            }
+
+            current_skeleton = this;
+            current_pool_request = preq.get();
+
+            eval_request(*preq);
+
+            current_skeleton = nullptr;
+            current_pool_request = nullptr;
+
+            std::lock_guard<std::mutex> lock(pending->mutex_);
+
+            if (--pending->running_ == 0)
+                pending->cond_.notify_all();
+        });
+    }
+    else
+    {
+        current_request_ = std::move(req);
+        eval_request(current_request_);
+    }
+
+    return DBUS_HANDLER_RESULT_HANDLED;
+}
+
+
+void SkeletonBase::eval_request(ServerRequestDescriptor& req)
+{
+    // keep the message, the request may be answered within the handler
+    message_ptr_t msg = make_message(dbus_message_ref(req.msg_));
+
+    const char* error_name = nullptr;
 
     try
     {
-        method.eval(msg);
+        req.requestor_->eval(msg.get());
     }
     catch(DecoderError&)
     {
-        // don't use `handle_error` as we may need to clear the current request
-        simppl::dbus::Error err(DBUS_ERROR_INVALID_ARGS);
-        auto r = detail::ErrorFactory<Error>::reply(*msg, err);
-
-        dbus_connection_send(disp_->conn_, r.get(), nullptr);
+        error_name = DBUS_ERROR_INVALID_ARGS;
     }
     catch(...)
+    {
+        error_name = "simppl.dbus.UnhandledException";
+    }
+
+    if (error_name)
     {
         // don't use `handle_error` as we may need to clear the current request
-        simppl::dbus::Error e("simppl.dbus.UnhandledException");
-        auto r = detail::ErrorFactory<Error>::reply(*msg, e);
+        simppl::dbus::Error err(error_name);
+        auto r = detail::ErrorFactory<Error>::reply(*msg, err);
 
-        dbus_connection_send(disp_->conn_, r.get(), nullptr);
+        if (req)
+        {
+            send_response(req, std::move(r));
+        }
+        else
+            send(std::move(r));
     }
 
-    // current_request_ is only valid if no response handler was called
-    if (current_request_)
-        current_request_.clear();
-
-    return DBUS_HANDLER_RESULT_HANDLED;
+    // req is only valid if no response handler was called
+    if (req)
+        req.clear();
 }
 
 
@@ -488,23 +965,25 @@ DBusHandlerResult SkeletonBase::handle_error(DBusMessage* msg, const char* dbus_
 
 
 #if SIMPPL_HAVE_INTROSPECTION
-void SkeletonBase::introspect_interface(std::ostream& os, size_type index) const
+void SkeletonBase::introspect_interface(std::ostream& os, const detail::InterfaceTable& table, size_type index) const
 {
-    os << "  <interface name=\""<< iface(index).c_str() << "\">\n";
+    auto& entry = table.ifaces_[index];
 
-    for (auto pm = method_heads_[index]; pm; pm = pm->next_)
+    os << "  <interface name=\""<< entry.name_ << "\">\n";
+
+    for (auto offset : entry.methods_)
     {
-        pm->introspect(os);
+        member<ServerMethodBase>(offset)->introspect(os);
     }
 
-    for (auto pp = this->property_heads_[index]; pp; pp = pp->next_)
+    for (auto offset : entry.properties_)
     {
-        pp->introspect(os);
+        member<ServerPropertyBase>(offset)->introspect(os);
     }
 
-    for (auto ps = this->signal_heads_[index]; ps; ps = ps->next_)
+    for (auto offset : entry.signals_)
     {
-        ps->introspect(os);
+        member<ServerSignalBase>(offset)->introspect(os);
     }
 
     os << "  </interface>\n";
@@ -513,66 +992,58 @@ void SkeletonBase::introspect_interface(std::ostream& os, size_type index) const
 
 bool SkeletonBase::has_any_properties() const
 {
-    const auto first = property_heads_.begin();
-    const auto last = property_heads_.end();
-    return std::find_if(first, last, [](ServerPropertyBase* ptr) { return ptr != nullptr; }) != last;
+    return table_->has_properties_;
 }
 
 
-int SkeletonBase::find_interface(const char* name) const
+void SkeletonBase::property_changed(int iface_id)
 {
-    for (size_type i = 0; i < ifaces_.size(); ++i)
+    if (property_cache_)
+        ++property_cache_[iface_id].generation_;
+}
+
+
+unsigned int SkeletonBase::properties_generation() const
+{
+    unsigned int generation = 0;
+
+    if (property_cache_)
     {
-        // use strcmp() because ifaces_[i] contains trailing zeros which causes
-        // operator== to fail.
-        if (!strcmp(ifaces_[i].c_str(), name))
-        {
-            // `ifaces_[0]` has the highest ID (e.g. N-1), so we need to
-            // "reverse" the order.
-            return static_cast<int>(ifaces_.size() - i - 1);
-        }
+        // each generation only grows, so does the sum
+        for (size_type i = 0; i < table_->ifaces_.size(); ++i)
+            generation += property_cache_[i].generation_;
     }
 
-    return invalid_iface_id;
+    return generation;
 }
 
 
-ServerPropertyBase* SkeletonBase::find_property(int iface_id, const char* name) const
+int SkeletonBase::find_interface(const char* name) const
 {
-    for (auto pp = property_heads_[iface_id]; pp; pp = pp->next_)
-    {
-        if (!strcmp(pp->name_, name))
-        {
-            return pp;
-        }
-    }
+    auto e = table_->index_.find(detail::DispatchIndex::Interface, name, "");
+    return e ? e->iface_id_ : invalid_iface_id;
+}
 
-    return nullptr;
+
+ServerPropertyBase* SkeletonBase::find_property(int iface_id, const char* name) const
+{
+    auto e = table_->index_.find(detail::DispatchIndex::Property, iface(iface_id).c_str(), name);
+    return e ? member<ServerPropertyBase>(e->offset_) : nullptr;
 }
 
 
 ServerMethodBase* SkeletonBase::find_method(int iface_id, const char* name) const
 {
-    for (auto pm = method_heads_[iface_id]; pm; pm = pm->next_)
-    {
-        if (!strcmp(pm->name_, name))
-        {
-            return pm;
-        }
-    }
-
-    return nullptr;
+    auto e = table_->index_.find(detail::DispatchIndex::Method, iface(iface_id).c_str(), name);
+    return e ? member<ServerMethodBase>(e->offset_) : nullptr;
 }
 
 
-void SkeletonBase::send_signal(const char* signame, int iface_id, std::function<void(DBusMessageIter&)>&& f)
+void SkeletonBase::send_signal(const char* signame, int iface_id, detail::function_ref<void(message_ptr_t&)> f)
 {
     message_ptr_t msg = make_message(dbus_message_new_signal(objectpath(), iface(iface_id).c_str(), signame));
 
-    DBusMessageIter iter;
-    dbus_message_iter_init_append(msg.get(), &iter);
-
-    f(iter);
+    f(msg);
 
     dbus_connection_send(disp_->conn_, msg.get(), nullptr);
 }
@@ -602,7 +1073,7 @@ void SkeletonBase::send_property_invalidate(const char* prop, int iface_id)
 }
 
 
-void SkeletonBase::send_property_change(const char* prop, int iface_id, std::function<void(DBusMessageIter&)>&& f)
+void SkeletonBase::send_property_change(const char* prop, int iface_id, detail::function_ref<void(DBusMessageIter&)> f)
 {
    static std::vector<std::string> invalid;
 
@@ -23,7 +23,7 @@ void StringCodec::encode(DBusMessageIter& iter, const std::string& str)
 void StringCodec::decode(DBusMessageIter& iter, std::string& str)
 {   
    char* c_str = nullptr;
-   simppl_dbus_message_iter_get_basic(&iter, &c_str, DBUS_TYPE_STRING);
+   detail::iter_get_basic(&iter, &c_str, DBUS_TYPE_STRING);
    
    if (c_str)
    {
@@ -48,7 +48,7 @@ void StringCodec::decode(DBusMessageIter& iter, char*& str)
    assert(str == nullptr);   // we allocate the string via Deserializer::alloc -> free with Deserializer::free
 
    char* c_str = nullptr;
-   simppl_dbus_message_iter_get_basic(&iter, &c_str, DBUS_TYPE_STRING);
+   detail::iter_get_basic(&iter, &c_str, DBUS_TYPE_STRING);
    
    // FIXME trouble with allocated memory in case of exception
    if (c_str)
@@ -59,6 +59,25 @@ void StringCodec::decode(DBusMessageIter& iter, char*& str)
 }
 
 
+/*static*/
+void StringCodec::encode(DBusMessageIter& iter, std::string_view str)
+{
+   // D-Bus expects a null-terminated string
+   std::string s(str);
+   encode(iter, s);
+}
+
+
+/*static*/
+void StringCodec::decode(DBusMessageIter& iter, std::string_view& str)
+{
+   char* c_str = nullptr;
+   detail::iter_get_basic(&iter, &c_str, DBUS_TYPE_STRING);
+
+   str = c_str ? std::string_view(c_str) : std::string_view();
+}
+
+
 /*static*/
 std::ostream& StringCodec::make_type_signature(std::ostream& os)
 {
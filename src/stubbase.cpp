@@ -152,6 +152,12 @@ DBusConnection* StubBase::conn()
 }
 
 
+detail::CallbackPool& StubBase::callback_pool()
+{
+    return disp().callback_pool();
+}
+
+
 Dispatcher& StubBase::disp()
 {
    assert(disp_);
@@ -246,19 +252,16 @@ StubBase::getall_properties_holder_type StubBase::get_all_properties_request_asy
 
     dbus_connection_send_with_reply(conn(), msg.get(), &pending, TimeoutRAIIHelper(disp()));
 
-    return getall_properties_holder_type(PendingCall(dbus_message_get_serial(msg.get()), pending), *this);
+    return getall_properties_holder_type(PendingCall(dbus_message_get_serial(msg.get()), pending), *this, callback_pool());
 }
 
 
-PendingCall StubBase::send_request(ClientMethodBase* method, std::function<void(DBusMessageIter&)>&& f, bool is_oneway)
+PendingCall StubBase::send_request(ClientMethodBase* method, detail::function_ref<void(message_ptr_t&)> f, bool is_oneway)
 {
     message_ptr_t msg = make_message(dbus_message_new_method_call(busname().c_str(), objectpath(), iface(), method->method_name_));
     DBusPendingCall* pending = nullptr;
 
-    DBusMessageIter iter;
-    dbus_message_iter_init_append(msg.get(), &iter);
-
-    f(iter);
+    f(msg);
 
     if (!is_oneway)
     {
@@ -277,16 +280,13 @@ PendingCall StubBase::send_request(ClientMethodBase* method, std::function<void(
 }
 
 
-message_ptr_t StubBase::send_request_and_block(ClientMethodBase* method, std::function<void(DBusMessageIter&)>&& f, bool is_oneway)
+message_ptr_t StubBase::send_request_and_block(ClientMethodBase* method, detail::function_ref<void(message_ptr_t&)> f, bool is_oneway)
 {
     message_ptr_t msg = make_message(dbus_message_new_method_call(busname().c_str(), objectpath(), iface(), method->method_name_));
     DBusPendingCall* pending = nullptr;
     message_ptr_t rc(nullptr, &dbus_message_unref);
 
-    DBusMessageIter iter;
-    dbus_message_iter_init_append(msg.get(), &iter);
-
-    f(iter);
+    f(msg);
 
     if (!is_oneway)
     {
@@ -476,7 +476,7 @@ message_ptr_t StubBase::get_property(const char* name)
 }
 
 
-void StubBase::set_property(const char* name, std::function<void(DBusMessageIter&)>&& f)
+void StubBase::set_property(const char* name, detail::function_ref<void(DBusMessageIter&)> f)
 {
     message_ptr_t msg = make_message(dbus_message_new_method_call(busname().c_str(), objectpath(), "org.freedesktop.DBus.Properties", "Set"));
 
@@ -508,7 +508,7 @@ void StubBase::set_property(const char* name, std::function<void(DBusMessageIter
 }
 
 
-PendingCall StubBase::set_property_async(const char* name, std::function<void(DBusMessageIter&)>&& f)
+PendingCall StubBase::set_property_async(const char* name, detail::function_ref<void(DBusMessageIter&)> f)
 {
     message_ptr_t msg = make_message(dbus_message_new_method_call(busname().c_str(), objectpath(), "org.freedesktop.DBus.Properties", "Set"));
 
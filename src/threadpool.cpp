@@ -0,0 +1,92 @@
+#include "simppl/threadpool.h"
+
+#include <algorithm>
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+namespace
+{
+
+__thread ThreadPool* current_pool = nullptr;
+
+}   // namespace
+
+
+ThreadPool::ThreadPool(std::size_t threads)
+ : stopped_(false)
+{
+   if (threads == 0)
+      threads = std::max(1u, std::thread::hardware_concurrency());
+
+   threads_.reserve(threads);
+
+   for (std::size_t i = 0; i < threads; ++i)
+      threads_.emplace_back(&ThreadPool::run, this);
+}
+
+
+ThreadPool::~ThreadPool()
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+   }
+
+   cond_.notify_all();
+
+   for (auto& t : threads_)
+      t.join();
+}
+
+
+void ThreadPool::post(std::function<void()> job)
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.emplace_back(std::move(job));
+   }
+
+   cond_.notify_one();
+}
+
+
+/*static*/
+ThreadPool* ThreadPool::current()
+{
+   return current_pool;
+}
+
+
+void ThreadPool::run()
+{
+   current_pool = this;
+
+   for(;;)
+   {
+      std::function<void()> job;
+
+      {
+         std::unique_lock<std::mutex> lock(mutex_);
+         cond_.wait(lock, [this](){ return stopped_ || !jobs_.empty(); });
+
+         // drain the queue before stopping
+         if (jobs_.empty())
+            break;
+
+         job = std::move(jobs_.front());
+         jobs_.pop_front();
+      }
+
+      job();
+   }
+}
+
+
+}   // namespace dbus
+
+}   // namespace simppl
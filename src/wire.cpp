@@ -0,0 +1,138 @@
+#include "simppl/detail/wire.h"
+
+#include "simppl/error.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+
+namespace simppl
+{
+
+namespace dbus
+{
+
+namespace detail
+{
+
+namespace
+{
+
+/// the header is the 16 bytes fixed part plus the fields array, padded to 8
+std::size_t body_offset(const char* data)
+{
+    uint32_t fields_len;
+    memcpy(&fields_len, data + 12, sizeof(fields_len));
+
+    return (16 + fields_len + 7) & ~std::size_t(7);
+}
+
+
+/**
+ * Append the signature header field to a marshalled header without body,
+ * as libdbus does when the first argument is appended.
+ */
+void append_signature_field(std::string& buf, const char* signature)
+{
+    std::size_t len = strlen(signature);
+
+    buf.resize(body_offset(buf.data()), '\0');
+
+    buf.push_back((char)DBUS_HEADER_FIELD_SIGNATURE);
+    buf.push_back((char)1);
+    buf.push_back(DBUS_TYPE_SIGNATURE);
+    buf.push_back('\0');
+    buf.push_back((char)len);
+    buf.append(signature, len + 1);
+
+    uint32_t fields_len = buf.size() - 16;
+    memcpy(&buf[12], &fields_len, sizeof(fields_len));
+
+    buf.resize(body_offset(buf.data()), '\0');
+}
+
+
+message_ptr_t make_wire_message(DBusMessage& tmpl, const char* signature, const char* body, std::size_t len)
+{
+    // libdbus refuses to demarshal messages without serial
+    if (dbus_message_get_serial(&tmpl) == 0)
+        dbus_message_set_serial(&tmpl, 1);
+
+    char* data = nullptr;
+    int data_len = 0;
+
+    if (!dbus_message_marshal(&tmpl, &data, &data_len))
+        throw std::bad_alloc();
+
+    std::size_t offset = body_offset(data);
+
+    std::string buf;
+    buf.reserve(offset + len + (signature ? strlen(signature) + 16 : 0));
+    buf.append(data, offset);
+
+    dbus_free(data);
+
+    if (signature)
+        append_signature_field(buf, signature);
+
+    buf.append(body, len);
+
+    uint32_t body_len = len;
+    memcpy(&buf[4], &body_len, sizeof(body_len));
+
+    DBusError err;
+    dbus_error_init(&err);
+
+    message_ptr_t msg = make_message(dbus_message_demarshal(buf.data(), buf.size(), &err));
+
+    if (dbus_error_is_set(&err))
+        throw RuntimeError("dbus_message_demarshal", std::move(err));
+
+    // the copy gets a fresh serial assigned on sending
+    return make_message(dbus_message_copy(msg.get()));
+}
+
+}   // namespace
+
+
+std::string wire_body(DBusMessage& msg)
+{
+    char* data = nullptr;
+    int len = 0;
+
+    if (!dbus_message_marshal(&msg, &data, &len))
+        throw std::bad_alloc();
+
+    std::size_t offset = body_offset(data);
+    std::string body(data + offset, len - offset);
+
+    dbus_free(data);
+
+    return body;
+}
+
+
+message_ptr_t wire_message(DBusMessage& tmpl, const char* body, std::size_t len)
+{
+    return make_wire_message(tmpl, nullptr, body, len);
+}
+
+
+message_ptr_t wire_message(DBusMessage& tmpl, const char* signature, const char* body, std::size_t len)
+{
+    const char* tmpl_signature = dbus_message_get_signature(&tmpl);
+
+    // the template's body is dropped, so it may only carry the same signature
+    assert(!*tmpl_signature || !strcmp(tmpl_signature, signature));
+
+    // templates without arguments have no signature field yet
+    return make_wire_message(tmpl, *tmpl_signature || !*signature ? nullptr : signature, body, len);
+}
+
+}   // namespace detail
+
+}   // namespace dbus
+
+}   // namespace simppl
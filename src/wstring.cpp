@@ -1,6 +1,7 @@
 #include "simppl/wstring.h"
 
 #include <cstring>
+#include <cwchar>
 #include <cassert>
 
 
@@ -10,6 +11,30 @@ namespace simppl
 namespace dbus
 {
 
+namespace
+{
+
+/// wide characters are transferred as one block of uint32 values
+int get_fixed_array(DBusMessageIter& iter, const wchar_t*& data)
+{
+   static_assert(sizeof(uint32_t) == sizeof(wchar_t), "data types mapping does not match");
+
+   DBusMessageIter _iter;
+   detail::iter_recurse(&iter, &_iter, DBUS_TYPE_ARRAY);
+
+   if (dbus_message_iter_get_element_type(&iter) != DBUS_TYPE_UINT32)
+      throw DecoderError();
+
+   int count = 0;
+   data = nullptr;
+   dbus_message_iter_get_fixed_array(&_iter, &data, &count);
+
+   return count;
+}
+
+}   // anonymous namespace
+
+
 
 /*static*/
 void WStringCodec::encode(DBusMessageIter& iter, const std::wstring& str)
@@ -20,9 +45,8 @@ void WStringCodec::encode(DBusMessageIter& iter, const std::wstring& str)
 
    dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, DBUS_TYPE_UINT32_AS_STRING, &_iter);
 
-   for (auto& t : str) {
-      Codec<uint32_t>::encode(_iter, (uint32_t)t);
-   }
+   const wchar_t* data = str.data();
+   dbus_message_iter_append_fixed_array(&_iter, DBUS_TYPE_UINT32, &data, str.size());
 
    dbus_message_iter_close_container(&iter, &_iter);
 }
@@ -31,26 +55,10 @@ void WStringCodec::encode(DBusMessageIter& iter, const std::wstring& str)
 /*static*/
 void WStringCodec::decode(DBusMessageIter& iter, std::wstring& str)
 {
-   str.clear();
+   const wchar_t* data;
+   int count = get_fixed_array(iter, data);
 
-   DBusMessageIter _iter;
-   simppl_dbus_message_iter_recurse(&iter, &_iter, DBUS_TYPE_ARRAY);
-
-   int count =
-#if DBUS_MAJOR_VERSION == 1 && DBUS_MINOR_VERSION < 9
-       dbus_message_iter_get_array_len(&_iter) / sizeof(uint32_t);
-#else
-       dbus_message_iter_get_element_count(&iter);
-#endif
-   if (count > 0)
-      str.reserve(count);
-
-   while(dbus_message_iter_get_arg_type(&_iter) != 0)
-   {
-      uint32_t t;
-      Codec<uint32_t>::decode(_iter, t);
-      str.push_back((wchar_t)t);
-   }
+   str.assign(data, count);
 
    // advance to next element
    dbus_message_iter_next(&iter);
@@ -64,9 +72,8 @@ void WStringCodec::encode(DBusMessageIter& iter, const wchar_t* str)
 
    dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, DBUS_TYPE_UINT32_AS_STRING, &_iter);
 
-   while(str && *str) {
-      Codec<uint32_t>::encode(_iter, (uint32_t)*str++);
-   }
+   if (str)
+      dbus_message_iter_append_fixed_array(&_iter, DBUS_TYPE_UINT32, &str, wcslen(str));
 
    dbus_message_iter_close_container(&iter, &_iter);
 }
@@ -79,27 +86,15 @@ void WStringCodec::decode(DBusMessageIter& iter, wchar_t*& str)
 
    //assert(str == nullptr);   // we allocate the string via Deserializer::alloc -> free with Deserializer::free
 
-   DBusMessageIter _iter;
-   simppl_dbus_message_iter_recurse(&iter, &_iter, DBUS_TYPE_ARRAY);
-
-   int count =
-#if DBUS_MAJOR_VERSION == 1 && DBUS_MINOR_VERSION < 9
-       dbus_message_iter_get_array_len(&_iter) / sizeof(uint32_t);
-#else
-       dbus_message_iter_get_element_count(&iter);
-#endif
+   const wchar_t* data;
+   int count = get_fixed_array(iter, data);
+
    if (count > 0)
    {
       c_str = new wchar_t[count+1];
       c_str[count] = 0;
 
-      int i = 0;
-      while(dbus_message_iter_get_arg_type(&_iter) != 0)
-      {
-         uint32_t t;
-         Codec<uint32_t>::decode(_iter, t);
-         c_str[i++] = (wchar_t)t;
-      }
+      memcpy(c_str, data, count * sizeof(wchar_t));
 
       str = c_str;
    }
@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+
+#include "simppl/stub.h"
+#include "simppl/skeleton.h"
+#include "simppl/interface.h"
+
+#include "simppl/detail/callbackpool.h"
+
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+using namespace std::literals::chrono_literals;
+
+using simppl::dbus::in;
+using simppl::dbus::out;
+
+
+namespace
+{
+
+std::atomic_bool count_allocations(false);
+std::atomic_int allocations(0);
+
+
+// not inlined, so the compiler does not pair malloc/free with new/delete
+__attribute__((noinline))
+void* allocate(std::size_t size)
+{
+   if (count_allocations)
+      ++allocations;
+
+   return ::malloc(size ? size : 1);
+}
+
+
+__attribute__((noinline))
+void deallocate(void* p)
+{
+   ::free(p);
+}
+
+}   // namespace
+
+
+// libdbus allocates via malloc, so only allocations on the C++ side are counted
+void* operator new(std::size_t size)
+{
+   if (void* p = allocate(size))
+      return p;
+
+   throw std::bad_alloc();
+}
+
+
+void operator delete(void* p) noexcept
+{
+   deallocate(p);
+}
+
+
+void operator delete(void* p, std::size_t) noexcept
+{
+   deallocate(p);
+}
+
+
+namespace test
+{
+
+INTERFACE(Allocations)
+{
+   Method<in<int>, in<double>, in<int>, out<int>, out<double>, out<int>> eval;
+   Method<in<int>> notify;
+
+   Signal<int, double, int> sig;
+
+   Property<int> prop;
+
+   inline
+   Allocations()
+    : INIT(eval)
+    , INIT(notify)
+    , INIT(sig)
+    , INIT(prop)
+   {
+      // NOOP
+   }
+};
+
+}   // namespace test
+
+using namespace test;
+
+
+namespace
+{
+
+struct Server : simppl::dbus::Skeleton<Allocations>
+{
+   Server(simppl::dbus::Dispatcher& d)
+    : simppl::dbus::Skeleton<Allocations>(d, "allocs")
+   {
+      eval >> [this](int i, double d, int j){
+         respond_with(eval(i, d, j));
+      };
+
+      notify >> [this](int i){
+         sig.notify(i, 3.1415, i);
+         prop = i;
+
+         respond_with(notify());
+      };
+
+      prop = 0;
+   }
+};
+
+}   // namespace
+
+
+TEST(Allocations, steady_state)
+{
+   simppl::dbus::Dispatcher sd("bus:session");
+   Server s(sd);
+
+   std::thread t([&sd](){
+      sd.run();
+   });
+
+   simppl::dbus::Dispatcher d;
+   simppl::dbus::Stub<Allocations> stub(d, "allocs");
+
+   // warm up: connection setup, name resolution and the like may allocate
+   for(int i=0; i<10; ++i)
+   {
+      stub.eval(i, 1.0, i);
+      stub.notify(i);
+   }
+
+   count_allocations = true;
+
+   for(int i=0; i<100; ++i)
+   {
+      auto rc = stub.eval(i, 2.0, i);
+      EXPECT_EQ(i, std::get<0>(rc));
+
+      stub.notify(i);
+   }
+
+   count_allocations = false;
+
+   EXPECT_EQ(0, allocations.load());
+
+   sd.stop();
+   t.join();
+}
+
+
+TEST(Allocations, async)
+{
+   simppl::dbus::Dispatcher sd("bus:session");
+   Server s(sd);
+
+   std::thread t([&sd](){
+      sd.run();
+   });
+
+   simppl::dbus::Dispatcher d;
+   simppl::dbus::Stub<Allocations> stub(d, "allocs");
+
+   int count = 0;
+
+   std::function<void()> next = [&](){
+      // warm up: the callback pool fills up with the first calls
+      if (count == 10)
+         count_allocations = true;
+
+      if (count++ == 110)
+      {
+         count_allocations = false;
+         d.stop();
+         return;
+      }
+
+      stub.eval.async(count, 2.0, count) >> [&](const simppl::dbus::CallState& cs, int i, double, int){
+         EXPECT_TRUE((bool)cs);
+         EXPECT_EQ(count, i);
+
+         next();
+      };
+   };
+
+   allocations = 0;
+
+   stub.connected >> [&](simppl::dbus::ConnectionState s){
+      if (s == simppl::dbus::ConnectionState::Connected)
+         next();
+   };
+
+   d.run();
+
+   EXPECT_EQ(111, count);
+   EXPECT_EQ(0, allocations.load());
+
+   sd.stop();
+   t.join();
+}
+
+
+TEST(Allocations, callback_pool)
+{
+   simppl::dbus::Dispatcher d;
+   simppl::dbus::detail::CallbackPool& pool = d.callback_pool();
+
+   void* p = pool.allocate(40);
+   pool.deallocate(p, 40);
+
+   // same size class
+   void* q = pool.allocate(64);
+   EXPECT_EQ(p, q);
+   pool.deallocate(q, 64);
+
+   // larger blocks are not recycled but still work
+   void* r = pool.allocate(4096);
+   pool.deallocate(r, 4096);
+}
@@ -0,0 +1,115 @@
+#include "simppl/vector.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+
+/**
+ * Microbenchmark of encoding and decoding 1 MB std::vector<double> payloads:
+ * the fixed array transfer of the vector codec versus appending and reading
+ * element by element as done before. Not a test, run it manually.
+ */
+
+namespace
+{
+
+typedef std::unique_ptr<DBusMessage, void(*)(DBusMessage*)> msg_type;
+
+constexpr int rounds = 200;
+
+
+msg_type make_message()
+{
+   return msg_type(dbus_message_new_signal("/bench", "bench.Array", "Data"), &dbus_message_unref);
+}
+
+
+/// the former codec: one call into libdbus per element
+struct ElementwiseCodec
+{
+   static
+   void encode(DBusMessageIter& s, const std::vector<double>& v)
+   {
+      DBusMessageIter iter;
+      dbus_message_iter_open_container(&s, DBUS_TYPE_ARRAY, DBUS_TYPE_DOUBLE_AS_STRING, &iter);
+
+      for (auto& t : v)
+         simppl::dbus::Codec<double>::encode(iter, t);
+
+      dbus_message_iter_close_container(&s, &iter);
+   }
+
+   static
+   void decode(DBusMessageIter& s, std::vector<double>& v)
+   {
+      v.clear();
+
+      DBusMessageIter iter;
+      simppl_dbus_message_iter_recurse(&s, &iter, DBUS_TYPE_ARRAY);
+
+      while(dbus_message_iter_get_arg_type(&iter) != 0)
+      {
+         double t;
+         simppl::dbus::Codec<double>::decode(iter, t);
+         v.push_back(t);
+      }
+
+      dbus_message_iter_next(&s);
+   }
+};
+
+
+template<typename CodecT>
+void measure(const char* name, const std::vector<double>& data)
+{
+   double encode_ms = 0;
+   double decode_ms = 0;
+
+   std::vector<double> out;
+
+   for (int i = 0; i < rounds; ++i)
+   {
+      auto msg = make_message();
+
+      auto start = std::chrono::steady_clock::now();
+
+      DBusMessageIter iter;
+      dbus_message_iter_init_append(msg.get(), &iter);
+      CodecT::encode(iter, data);
+
+      auto mid = std::chrono::steady_clock::now();
+
+      dbus_message_iter_init(msg.get(), &iter);
+      CodecT::decode(iter, out);
+
+      auto end = std::chrono::steady_clock::now();
+
+      encode_ms += std::chrono::duration<double, std::milli>(mid - start).count();
+      decode_ms += std::chrono::duration<double, std::milli>(end - mid).count();
+   }
+
+   if (out != data)
+      fprintf(stderr, "%s: roundtrip failed\n", name);
+
+   printf("%-12s %12.3f %12.3f\n", name, encode_ms / rounds, decode_ms / rounds);
+}
+
+}   // namespace
+
+
+int main()
+{
+   std::vector<double> data((1 << 20) / sizeof(double));
+
+   for (std::size_t i = 0; i < data.size(); ++i)
+      data[i] = i * 0.5;
+
+   printf("%-12s %12s %12s\n", "1 MB", "encode [ms]", "decode [ms]");
+
+   measure<simppl::dbus::Codec<std::vector<double>>>("fixed array", data);
+   measure<ElementwiseCodec>("elementwise", data);
+
+   return 0;
+}
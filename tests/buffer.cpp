@@ -5,7 +5,11 @@
 #include "simppl/dispatcher.h"
 #include "simppl/interface.h"
 #include "simppl/buffer.h"
+#include "simppl/arrayview.h"
+#include "simppl/string.h"
+#include "simppl/vector.h"
 
+#include <algorithm>
 #include <thread>
 
 
@@ -24,11 +28,13 @@ INTERFACE(Buffer)
    Method<simppl::dbus::oneway> stop;
 
    Method<in<simppl::dbus::FixedSizeBuffer<16>>, out<simppl::dbus::FixedSizeBuffer<16>>> echo;
+   Method<in<simppl::dbus::BufferView>, out<simppl::dbus::BufferView>> echo_view;
    
    inline
    Buffer()
     : INIT(stop)
     , INIT(echo)
+    , INIT(echo_view)
    {
       // NOOP
    }
@@ -74,6 +80,13 @@ struct Server : simppl::dbus::Skeleton<Buffer>
          
          respond_with(echo(buf));
       };
+
+
+      echo_view >> [this](const simppl::dbus::BufferView& view)
+      {
+         EXPECT_EQ(4u, view.size());
+         respond_with(echo_view(view));
+      };
    }
 };
 
@@ -109,3 +122,72 @@ TEST(Buffer, echo)
    stub.stop();   // stop server
    t.join();
 }
+
+
+TEST(Buffer, view)
+{
+   simppl::dbus::Dispatcher d("bus:session");
+   
+   std::thread t([](){
+      simppl::dbus::Dispatcher d("bus:session");
+      Server s(d, "buf");
+      d.run();
+   });
+
+   simppl::dbus::Stub<Buffer> stub(d, "buf");
+
+   // wait for server to get ready
+   std::this_thread::sleep_for(100ms);
+
+   uint8_t data[] = { 1, 2, 3, 4 };
+   
+   // the view holds the reply message
+   simppl::dbus::BufferView view = stub.echo_view(simppl::dbus::BufferView(data, sizeof(data)));
+   
+   ASSERT_EQ(sizeof(data), view.size());
+   EXPECT_NE(data, view.data());
+   EXPECT_EQ(0, ::memcmp(data, view.data(), sizeof(data)));
+   
+   stub.stop();   // stop server
+   t.join();
+}
+
+
+TEST(Buffer, view_lifetime)
+{
+   using namespace simppl::dbus;
+
+   DBusMessage* msg = dbus_message_new_signal("/a/b", "a.b", "c");
+
+   std::vector<uint8_t> data{ 1, 2, 3 };
+
+   DBusMessageIter iter;
+   dbus_message_iter_init_append(msg, &iter);
+   encode(iter, data, std::string("Hello"));
+
+   BufferView view;
+   std::string_view str;
+
+   dbus_message_iter_init(msg, &iter);
+   decode(iter, view, str);
+
+   EXPECT_EQ(std::string_view("Hello"), str);
+
+   // the view keeps the message alive
+   dbus_message_unref(msg);
+
+   BufferView copy(view);
+   view = BufferView();
+
+   EXPECT_TRUE(std::equal(data.begin(), data.end(), copy.begin(), copy.end()));
+
+   // wrong element type
+   msg = dbus_message_new_signal("/a/b", "a.b", "c");
+   dbus_message_iter_init_append(msg, &iter);
+   encode(iter, std::vector<int>{ 1 });
+
+   dbus_message_iter_init(msg, &iter);
+   EXPECT_THROW(decode(iter, view), DecoderError);
+
+   dbus_message_unref(msg);
+}
@@ -0,0 +1,271 @@
+#include <gtest/gtest.h>
+
+#include "simppl/stub.h"
+#include "simppl/skeleton.h"
+#include "simppl/dispatcher.h"
+#include "simppl/interface.h"
+#include "simppl/coroutine.h"
+#include "simppl/threadpool.h"
+
+#include "simppl/string.h"
+
+
+using simppl::dbus::in;
+using simppl::dbus::out;
+
+
+namespace test
+{
+
+INTERFACE(Coro)
+{
+   Method<in<int>, in<int>, out<int>> add;
+   Method<in<int>, out<int>, out<std::string>> echo;
+   Method<> fail;
+
+   Property<int> value;
+   Property<int, simppl::dbus::ReadWrite> writable;
+
+   inline
+   Coro()
+    : INIT(add)
+    , INIT(echo)
+    , INIT(fail)
+    , INIT(value)
+    , INIT(writable)
+   {
+      // NOOP
+   }
+};
+
+}   // namespace
+
+using namespace test;
+
+
+namespace
+{
+
+struct Server : simppl::dbus::Skeleton<Coro>
+{
+   Server(simppl::dbus::Dispatcher& d, const char* rolename)
+    : simppl::dbus::Skeleton<Coro>(d, rolename)
+   {
+      add >> [this](int i, int j){
+         respond_with(add(i + j));
+      };
+
+      echo >> [this](int i){
+         respond_with(echo(i, std::to_string(i)));
+      };
+
+      fail >> [this](){
+         respond_with(simppl::dbus::Error("Test.Failed"));
+      };
+
+      value = 42;
+      writable = 1;
+   }
+};
+
+
+simppl::dbus::Task<int> add_twice(simppl::dbus::Stub<Coro>& stub, int i)
+{
+   int rc = co_await stub.add.async(i, i);
+   co_return co_await stub.add.async(rc, rc);
+}
+
+
+simppl::dbus::Task<> sequence(simppl::dbus::Stub<Coro>& stub, std::vector<std::string>& steps)
+{
+   int sum = co_await stub.add.async(1, 2);
+   EXPECT_EQ(3, sum);
+   steps.push_back("add");
+
+   auto [i, str] = co_await stub.echo.async(7);
+   EXPECT_EQ(7, i);
+   EXPECT_EQ("7", str);
+   steps.push_back("echo");
+
+   EXPECT_EQ(8, co_await add_twice(stub, 2));
+   steps.push_back("nested");
+
+   EXPECT_EQ(42, co_await stub.value.get_async());
+   steps.push_back("get");
+
+   co_await stub.writable.set_async(2);
+   EXPECT_EQ(2, co_await stub.writable.get_async());
+   steps.push_back("set");
+
+   int cb_value = 0;
+   stub.value >> [&cb_value](const simppl::dbus::CallState& cs, int i){
+      cb_value = i;
+   };
+
+   co_await stub.get_all_properties.async();
+   EXPECT_EQ(42, cb_value);
+   steps.push_back("getall");
+
+   try
+   {
+      co_await stub.fail.async();
+      ADD_FAILURE() << "no exception";
+   }
+   catch(const simppl::dbus::Error& err)
+   {
+      EXPECT_STREQ("Test.Failed", err.name());
+      steps.push_back("error");
+   }
+
+   stub.disp().stop();
+}
+
+}   // namespace
+
+
+TEST(Coroutine, client)
+{
+   simppl::dbus::Dispatcher d("bus:session");
+
+   Server s(d, "s");
+   simppl::dbus::Stub<Coro> stub(d, "s");
+
+   std::vector<std::string> steps;
+
+   stub.connected >> [&](simppl::dbus::ConnectionState st){
+      // dropped task, runs to completion on its own
+      sequence(stub, steps);
+   };
+
+   d.run();
+
+   std::vector<std::string> expected = { "add", "echo", "nested", "get", "set", "getall", "error" };
+   EXPECT_EQ(expected, steps);
+}
+
+
+namespace test
+{
+
+INTERFACE(Proxy)
+{
+   Method<in<int>, out<int>> twice;
+   Method<in<int>, out<int>, out<std::string>> both;
+   Method<in<int>> nothing;
+   Method<> fail;
+   Method<in<int>, out<int>> heavy;
+
+   inline
+   Proxy()
+    : INIT(twice)
+    , INIT(both)
+    , INIT(nothing)
+    , INIT(fail)
+    , INIT(heavy)
+   {
+      // NOOP
+   }
+};
+
+}   // namespace
+
+
+namespace
+{
+
+struct ProxyServer : simppl::dbus::Skeleton<Proxy>
+{
+   ProxyServer(simppl::dbus::Dispatcher& d, const char* rolename, simppl::dbus::ThreadPool& pool)
+    : simppl::dbus::Skeleton<Proxy>(d, rolename)
+    , upstream_(d, "s")
+   {
+      // forward to the upstream service
+      twice >> [this](int i) -> simppl::dbus::Task<int> {
+         co_return co_await upstream_.add.async(i, i);
+      };
+
+      both >> [this](int i) -> simppl::dbus::Task<std::tuple<int, std::string>> {
+         auto [j, str] = co_await upstream_.echo.async(i);
+         co_return std::make_tuple(j, str + "!");
+      };
+
+      nothing >> [this](int i) -> simppl::dbus::Task<> {
+         co_await upstream_.add.async(i, i);
+      };
+
+      fail >> [this]() -> simppl::dbus::Task<> {
+         co_await upstream_.fail.async();
+      };
+
+      heavy >> [this, &pool](int i) -> simppl::dbus::Task<int> {
+         auto id = std::this_thread::get_id();
+
+         co_await simppl::dbus::resume_on(pool);
+         EXPECT_NE(id, std::this_thread::get_id());
+
+         int rc = i * i;
+
+         co_await simppl::dbus::resume_on(disp());
+         EXPECT_EQ(id, std::this_thread::get_id());
+
+         co_return rc;
+      };
+   }
+
+   simppl::dbus::Stub<Coro> upstream_;
+};
+
+
+simppl::dbus::Task<> proxy_sequence(simppl::dbus::Stub<Proxy>& stub, int& steps)
+{
+   EXPECT_EQ(10, co_await stub.twice.async(5));
+   ++steps;
+
+   auto [i, str] = co_await stub.both.async(3);
+   EXPECT_EQ(3, i);
+   EXPECT_EQ("3!", str);
+   ++steps;
+
+   co_await stub.nothing.async(1);
+   ++steps;
+
+   try
+   {
+      co_await stub.fail.async();
+      ADD_FAILURE() << "no exception";
+   }
+   catch(const simppl::dbus::Error& err)
+   {
+      EXPECT_STREQ("Test.Failed", err.name());
+      ++steps;
+   }
+
+   EXPECT_EQ(49, co_await stub.heavy.async(7));
+   ++steps;
+
+   stub.disp().stop();
+}
+
+}   // namespace
+
+
+TEST(Coroutine, server)
+{
+   simppl::dbus::ThreadPool pool(1);
+   simppl::dbus::Dispatcher d("bus:session");
+
+   Server s(d, "s");
+   ProxyServer p(d, "p", pool);
+
+   simppl::dbus::Stub<Proxy> stub(d, "p");
+
+   int steps = 0;
+
+   stub.connected >> [&](simppl::dbus::ConnectionState st){
+      proxy_sequence(stub, steps);
+   };
+
+   d.run();
+
+   EXPECT_EQ(5, steps);
+}
@@ -0,0 +1,99 @@
+#include "simppl/vector.h"
+#include "simppl/map.h"
+#include "simppl/string.h"
+#include "simppl/tuple.h"
+#include "simppl/detail/callinterface.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+/**
+ * Microbenchmark of decoding request arguments of large nested arrays: the
+ * message signature checked once followed by decoding without type checks
+ * versus checking the type of every single element. Not a test, run it
+ * manually.
+ */
+
+using namespace simppl::dbus;
+
+
+namespace
+{
+
+typedef std::unique_ptr<DBusMessage, void(*)(DBusMessage*)> msg_type;
+
+constexpr int rounds = 20;
+
+
+template<typename... T>
+void measure(const char* name, const T&... args)
+{
+   typedef detail::DeserializeAndCall<std::tuple<T...>> caller_type;
+
+   msg_type msg(dbus_message_new_method_call("bench.Decode", "/bench", "bench.Decode", "Eval"), &dbus_message_unref);
+
+   DBusMessageIter iter;
+   dbus_message_iter_init_append(msg.get(), &iter);
+   encode(iter, args...);
+
+   std::size_t calls = 0;
+   auto f = [&calls](const T&...){ ++calls; };
+
+   double checked_ms = 0;
+   double validated_ms = 0;
+
+   for (int i = 0; i < rounds; ++i)
+   {
+      auto start = std::chrono::steady_clock::now();
+
+      dbus_message_iter_init(msg.get(), &iter);
+      caller_type::eval(iter, f);
+
+      auto mid = std::chrono::steady_clock::now();
+
+      if (!strcmp(dbus_message_get_signature(msg.get()), caller_type::signature()))
+      {
+         dbus_message_iter_init(msg.get(), &iter);
+         caller_type::eval(iter, f, true);
+      }
+
+      auto end = std::chrono::steady_clock::now();
+
+      checked_ms += std::chrono::duration<double, std::milli>(mid - start).count();
+      validated_ms += std::chrono::duration<double, std::milli>(end - mid).count();
+   }
+
+   if (calls != 2 * rounds)
+      fprintf(stderr, "%s: signature mismatch\n", name);
+
+   printf("%-14s %14.2f %14.2f\n", name, checked_ms / rounds, validated_ms / rounds);
+}
+
+}   // namespace
+
+
+int main()
+{
+   std::vector<std::vector<std::string>> strings(1000, std::vector<std::string>(100, "Hello World"));
+
+   std::vector<std::vector<std::tuple<int, double>>> tuples(1000, std::vector<std::tuple<int, double>>(100, std::make_tuple(42, 3.1415)));
+
+   std::map<int, std::tuple<int, std::string, double>> entries;
+   for (int i = 0; i < 100000; ++i)
+      entries[i] = std::make_tuple(i, "Hello World", i * 0.5);
+
+   printf("%-14s %14s %14s\n", "100k elements", "checked [ms]", "validated [ms]");
+
+   measure("aas", strings);
+   measure("aa(id)", tuples);
+   measure("a{i(isd)}", entries);
+
+   return 0;
+}
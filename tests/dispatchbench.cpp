@@ -0,0 +1,129 @@
+#include "simppl/skeleton.h"
+#include "simppl/interface.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+/**
+ * Microbenchmark of the method lookup of incoming requests: the hashed
+ * dispatch index of SkeletonBase versus a linear scan of the methods list
+ * as done before. Not a test, run it manually.
+ */
+
+using simppl::dbus::in;
+using simppl::dbus::out;
+
+
+namespace
+{
+
+typedef simppl::dbus::ServerMethod<in<int>, out<int>> method_type;
+
+
+struct BenchSkeleton : simppl::dbus::SkeletonBase
+{
+   BenchSkeleton(std::size_t ifaces, std::size_t methods)
+    : simppl::dbus::SkeletonBase(ifaces)
+   {
+      names_.reserve(methods);
+      for (std::size_t i = 0; i < methods; ++i)
+         names_.push_back("Method" + std::to_string(i));
+
+      for (std::size_t i = 0; i < ifaces; ++i)
+      {
+         ifaces_.push_back("test.bench.Interface" + std::to_string(i));
+
+         for (auto& name : names_)
+            methods_.emplace_back(new method_type(name.c_str(), this, ifaces - i - 1));
+      }
+
+      init_table("bench:" + std::to_string(ifaces) + ":" + std::to_string(methods), ifaces_);
+   }
+
+   simppl::dbus::ServerMethodBase* hashed(const char* iface, const char* method) const
+   {
+      auto e = table_->index_.find(simppl::dbus::detail::DispatchIndex::Method, iface, method);
+      return e ? member<simppl::dbus::ServerMethodBase>(e->offset_) : nullptr;
+   }
+
+   /// the former lookup: find the interface, then walk the methods list
+   simppl::dbus::ServerMethodBase* linear(const char* iface, const char* method) const
+   {
+      for (std::size_t i = 0; i < ifaces_.size(); ++i)
+      {
+         if (!strcmp(ifaces_[i].c_str(), iface))
+         {
+            for (std::size_t j = i * names_.size(); j < (i + 1) * names_.size(); ++j)
+            {
+               if (!strcmp(methods_[j]->name_, method))
+                  return methods_[j].get();
+            }
+
+            return nullptr;
+         }
+      }
+
+      return nullptr;
+   }
+
+   std::vector<std::string> ifaces_;
+   std::vector<std::string> names_;
+   std::vector<std::unique_ptr<method_type>> methods_;
+};
+
+
+template<typename FuncT>
+double measure(BenchSkeleton& skel, FuncT&& lookup)
+{
+   constexpr int rounds = 200000;
+
+   // request each method of each interface in turn
+   std::vector<std::pair<const char*, const char*>> requests;
+   for (auto& iface : skel.ifaces_)
+      for (auto& name : skel.names_)
+         requests.emplace_back(iface.c_str(), name.c_str());
+
+   std::size_t found = 0;
+   auto start = std::chrono::steady_clock::now();
+
+   for (int i = 0; i < rounds; ++i)
+   {
+      auto& r = requests[i % requests.size()];
+      found += lookup(r.first, r.second) != nullptr;
+   }
+
+   auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+   if (found != (std::size_t)rounds)
+      fprintf(stderr, "lookup failed\n");
+
+   return double(ns) / rounds;
+}
+
+}   // namespace
+
+
+int main()
+{
+   printf("%8s %8s %12s %12s\n", "ifaces", "methods", "hashed [ns]", "linear [ns]");
+
+   for (std::size_t ifaces : { 1, 4, 8 })
+   {
+      for (std::size_t methods : { 1, 8, 16, 64, 256 })
+      {
+         BenchSkeleton skel(ifaces, methods);
+
+         double h = measure(skel, [&skel](const char* iface, const char* method){ return skel.hashed(iface, method); });
+         double l = measure(skel, [&skel](const char* iface, const char* method){ return skel.linear(iface, method); });
+
+         printf("%8zu %8zu %12.1f %12.1f\n", ifaces, methods, h, l);
+      }
+   }
+
+   return 0;
+}
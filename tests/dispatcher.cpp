@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include "simppl/dispatcher.h"
+#include "simppl/shardeddispatcher.h"
+#include "simppl/stub.h"
+#include "simppl/skeleton.h"
+#include "simppl/interface.h"
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+
+
+using namespace std::literals::chrono_literals;
+
+using simppl::dbus::in;
+using simppl::dbus::out;
+
+
+namespace test
+{
+
+INTERFACE(Shard)
+{
+   Method<in<int>, out<int>> echo;
+
+   inline
+   Shard()
+    : INIT(echo)
+   {
+      // NOOP
+   }
+};
+
+}   // namespace
+
+using namespace test;
+
+
+namespace
+{
+
+struct ShardServer : simppl::dbus::Skeleton<Shard>
+{
+   ShardServer(simppl::dbus::Dispatcher& d, const char* busname, const char* objectpath)
+    : simppl::dbus::Skeleton<Shard>(d, busname, objectpath)
+   {
+      echo >> [this](int i){
+         respond_with(echo(i));
+      };
+   }
+};
+
+}   // namespace
+
+
+TEST(Dispatcher, post_in_order)
+{
+   simppl::dbus::Dispatcher d;
+
+   std::vector<int> results;
+
+   for(int i=0; i<100; ++i)
+      d.post([&results, i](){ results.push_back(i); });
+
+   d.post([&d](){ d.stop(); });
+
+   d.run();
+
+   ASSERT_EQ(100u, results.size());
+
+   for(int i=0; i<100; ++i)
+      EXPECT_EQ(i, results[i]);
+}
+
+
+TEST(Dispatcher, post_from_threads)
+{
+   simppl::dbus::Dispatcher d;
+
+   constexpr int threads = 4;
+   constexpr int tasks = 1000;
+
+   int count = 0;   // only touched on the loop thread
+   std::atomic_int done(0);
+
+   std::vector<std::thread> producers;
+
+   for(int i=0; i<threads; ++i)
+   {
+      producers.emplace_back([&](){
+         for(int j=0; j<tasks; ++j)
+            d.post([&count](){ ++count; });
+
+         if (++done == threads)
+            d.post([&d](){ d.stop(); });
+      });
+   }
+
+   d.run();
+
+   for(auto& t : producers)
+      t.join();
+
+   EXPECT_EQ(threads * tasks, count);
+}
+
+
+TEST(Dispatcher, post_at)
+{
+   simppl::dbus::Dispatcher d;
+
+   std::vector<int> results;
+
+   auto start = std::chrono::steady_clock::now();
+   std::chrono::steady_clock::time_point end;
+
+   d.post_at(start + 100ms, [&](){
+      results.push_back(2);
+
+      end = std::chrono::steady_clock::now();
+      d.stop();
+   });
+
+   d.post_at(start + 50ms, [&results](){ results.push_back(1); });
+
+   d.run();
+
+   ASSERT_EQ(2u, results.size());
+   EXPECT_EQ(1, results[0]);
+   EXPECT_EQ(2, results[1]);
+
+   long millis = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+   EXPECT_GE(millis, 100);
+}
+
+
+TEST(Dispatcher, sharded)
+{
+   simppl::dbus::ShardedDispatcher sd(2);
+   EXPECT_EQ(2u, sd.size());
+
+   ShardServer s1(sd.shard_for("test.shard.a", "/a"), "test.shard.a", "/a");
+   ShardServer s2(sd.shard_for("test.shard.b", "/b"), "test.shard.b", "/b");
+   ShardServer s3(sd.shard_for("test.shard.a", "/c"), "test.shard.a", "/c");
+
+   // objects of one busname share the connection owning the name
+   EXPECT_EQ(&s1.disp(), &s3.disp());
+
+   std::thread t([&sd](){
+      sd.run();
+   });
+
+   simppl::dbus::Dispatcher d;
+
+   simppl::dbus::Stub<Shard> a(d, "test.shard.a", "/a");
+   simppl::dbus::Stub<Shard> b(d, "test.shard.b", "/b");
+   simppl::dbus::Stub<Shard> c(d, "test.shard.a", "/c");
+
+   EXPECT_EQ(1, a.echo(1));
+   EXPECT_EQ(2, b.echo(2));
+   EXPECT_EQ(3, c.echo(3));
+
+   sd.stop();
+   t.join();
+
+   EXPECT_GE(sd.statistics().messages, 3u);
+}
+
+
+TEST(Dispatcher, sharded_exception)
+{
+   simppl::dbus::ShardedDispatcher sd(2);
+
+   sd.shard(1).post([](){
+      throw std::runtime_error("shard 1");
+   });
+
+   EXPECT_THROW(sd.run(), std::runtime_error);
+}
@@ -100,4 +100,37 @@ TEST(NoInterface, introspect)
     IntrospectClient client(disp);
     disp.run();
 }
+
+
+TEST(NoInterface, introspect_children)
+{
+    simppl::dbus::Dispatcher sd("bus:session");
+    simppl::dbus::Skeleton<> root(sd, "simppl.test.children", "/");
+
+    std::thread t([&sd](){
+        sd.run();
+    });
+
+    simppl::dbus::Dispatcher d;
+    simppl::dbus::Stub<org::freedesktop::DBus::Introspectable> stub(d, "simppl.test.children", "/");
+
+    std::string xml = stub.Introspect();
+    EXPECT_EQ(std::string::npos, xml.find("<node name=\"child\"/>"));
+
+    // cached document
+    EXPECT_EQ(xml, stub.Introspect());
+
+    {
+        simppl::dbus::Skeleton<> child(sd, "simppl.test.children", "/child");
+
+        xml = stub.Introspect();
+        EXPECT_NE(std::string::npos, xml.find("<node name=\"child\"/>\n</node>\n"));
+    }
+
+    xml = stub.Introspect();
+    EXPECT_EQ(std::string::npos, xml.find("<node name=\"child\"/>"));
+
+    sd.stop();
+    t.join();
+}
 #endif   // SIMPPL_HAVE_INTROSPECTION
@@ -4,10 +4,14 @@
 #include "simppl/skeleton.h"
 #include "simppl/dispatcher.h"
 #include "simppl/interface.h"
+#include "simppl/objectmanagerclient.h"
 
 #include <functional>
 #include <thread>
 #include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
 
 
 using namespace std::literals::chrono_literals;
@@ -182,3 +186,289 @@ TEST(ObjectManager, add_remove)
 
     s.run();
 }
+
+
+TEST(ObjectManager, cached_and_paged)
+{
+    simppl::dbus::Dispatcher s("bus:session");
+
+    simppl::dbus::Skeleton<org::freedesktop::DBus::ObjectManager> mgr(s, "test.paged", "/");
+
+    std::vector<std::unique_ptr<simppl::dbus::Skeleton<test::One>>> objs;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        objs.emplace_back(new simppl::dbus::Skeleton<test::One>(s, "test.paged", "/test/paged/" + std::to_string(i)));
+        objs.back()->Str = "Hallo";
+        objs.back()->Int = i;
+
+        mgr.add_managed_object(objs.back().get());
+    }
+
+    std::thread t([&s](){
+        s.run();
+    });
+
+    simppl::dbus::Dispatcher c;
+
+    simppl::dbus::Stub<org::freedesktop::DBus::ObjectManager> clnt(c, "test.paged", "/");
+    simppl::dbus::Stub<simppl::dbus::ext::ObjectManager> pclnt(c, "test.paged", "/");
+
+    auto all = clnt.GetManagedObjects();
+    ASSERT_EQ(5, all.size());
+    EXPECT_EQ(3, all[simppl::dbus::ObjectPath("/test/paged/3")]["test.One"]["Int"].as<int>());
+    EXPECT_EQ("Hallo", all[simppl::dbus::ObjectPath("/test/paged/3")]["test.One"]["Str"].as<std::string>());
+
+    // a property change invalidates the cached entry of the object
+    std::promise<void> changed;
+    s.post([&objs, &changed](){
+        objs[3]->Int = 42;
+        changed.set_value();
+    });
+    changed.get_future().wait();
+
+    all = clnt.GetManagedObjects();
+    ASSERT_EQ(5, all.size());
+    EXPECT_EQ(42, all[simppl::dbus::ObjectPath("/test/paged/3")]["test.One"]["Int"].as<int>());
+    EXPECT_EQ(2, all[simppl::dbus::ObjectPath("/test/paged/2")]["test.One"]["Int"].as<int>());
+
+    // page through all objects
+    std::vector<std::string> paths;
+    std::string after;
+
+    for(;;)
+    {
+        auto page = pclnt.GetManagedObjectsPaged(after, 2);
+
+        for (auto& o : page)
+            paths.push_back(o.first.path);
+
+        if (page.size() < 2)
+            break;
+
+        after = paths.back();
+    }
+
+    ASSERT_EQ(5, paths.size());
+    for (int i = 0; i < 5; ++i)
+        EXPECT_EQ("/test/paged/" + std::to_string(i), paths[i]);
+
+    s.stop();
+    t.join();
+}
+
+
+TEST(ObjectManager, batched)
+{
+    simppl::dbus::Dispatcher s("bus:session");
+
+    simppl::dbus::Skeleton<org::freedesktop::DBus::ObjectManager> mgr(s, "test.batched", "/");
+
+    std::vector<std::unique_ptr<simppl::dbus::Skeleton<test::One>>> objs;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        objs.emplace_back(new simppl::dbus::Skeleton<test::One>(s, "test.batched", "/test/batched/" + std::to_string(i)));
+        objs.back()->Str = "Hallo";
+        objs.back()->Int = i;
+    }
+
+    simppl::dbus::Stub<org::freedesktop::DBus::ObjectManager> clnt(s, "test.batched", "/");
+
+    std::vector<std::string> added;
+    std::vector<std::string> removed;
+
+    clnt.InterfacesAdded.attach() >> [&](const simppl::dbus::ObjectPath& p, const std::map<std::string, std::map<std::string, simppl::dbus::Any>>& ifaces){
+        added.push_back(p.path);
+
+        auto props = ifaces.find("test.One");
+        ASSERT_NE(props, ifaces.end());
+        EXPECT_EQ(p.path.back() - '0', props->second.at("Int").as<int>());
+    };
+
+    clnt.InterfacesRemoved.attach() >> [&](const simppl::dbus::ObjectPath& p, const std::vector<std::string>&){
+        removed.push_back(p.path);
+
+        // the removal of the remaining objects
+        if (removed.size() == 3)
+            s.stop();
+    };
+
+    clnt.connected >> [&](simppl::dbus::ConnectionState){
+
+        mgr.add_managed_objects(objs.begin(), objs.end());
+
+        // never announced
+        mgr.remove_managed_objects(objs.begin() + 3, objs.end());
+
+        clnt.GetManagedObjects.async() >> [&](const simppl::dbus::CallState&, const org::freedesktop::DBus::managed_objects_t& objects){
+            EXPECT_EQ(3u, objects.size());
+
+            mgr.remove_managed_objects(objs.begin(), objs.begin() + 3);
+        };
+    };
+
+    s.run();
+
+    EXPECT_EQ((std::vector<std::string>{ "/test/batched/0", "/test/batched/1", "/test/batched/2" }), added);
+    EXPECT_EQ((std::vector<std::string>{ "/test/batched/0", "/test/batched/1", "/test/batched/2" }), removed);
+}
+
+
+TEST(ObjectManager, destroyed_while_batched)
+{
+    simppl::dbus::Dispatcher s("bus:session");
+
+    std::unique_ptr<simppl::dbus::Skeleton<org::freedesktop::DBus::ObjectManager>> mgr(new simppl::dbus::Skeleton<org::freedesktop::DBus::ObjectManager>(s, "test.teardown", "/"));
+
+    simppl::dbus::Skeleton<test::One> o(s, "test.teardown", "/test/teardown/one");
+    o.Str = "Hallo";
+    o.Int = 42;
+
+    std::vector<simppl::dbus::SkeletonBase*> objs = { &o };
+
+    simppl::dbus::Stub<org::freedesktop::DBus::ObjectManager> clnt(s, "test.teardown", "/");
+
+    std::vector<std::string> removed;
+
+    clnt.InterfacesRemoved.attach() >> [&](const simppl::dbus::ObjectPath& p, const std::vector<std::string>&){
+        removed.push_back(p.path);
+        s.stop();
+    };
+
+    clnt.connected >> [&](simppl::dbus::ConnectionState){
+
+        mgr->add_managed_object(&o);
+
+        // the removal is still pending on destruction
+        mgr->remove_managed_objects(objs.begin(), objs.end());
+        mgr.reset();
+    };
+
+    s.run();
+
+    EXPECT_EQ((std::vector<std::string>{ "/test/teardown/one" }), removed);
+}
+
+
+TEST(ObjectManager, client_mirror)
+{
+    simppl::dbus::Dispatcher s("bus:session");
+
+    simppl::dbus::Skeleton<org::freedesktop::DBus::ObjectManager> mgr(s, "test.mirror", "/");
+
+    simppl::dbus::Skeleton<test::One> o(s, "test.mirror", "/test/mirror/one");
+    o.Str = "Hallo";
+    o.Int = 42;
+
+    simppl::dbus::Skeleton<test::Two, test::Three> t(s, "test.mirror", "/test/mirror/two");
+    t.Double = 3.1415;
+    t.Int = 4711;
+    t.Obj = "/Super/Toll";
+
+    mgr.add_managed_object(&o);
+    mgr.add_managed_object(&t);
+
+    simppl::dbus::ObjectManagerClient clnt(s, "test.mirror", "/");
+
+    int changes = 0;
+
+    clnt.synced = [&](simppl::dbus::ConnectionState state){
+        EXPECT_EQ(simppl::dbus::ConnectionState::Connected, state);
+        EXPECT_TRUE(clnt.is_synced());
+
+        ASSERT_EQ(2u, clnt.objects().size());
+        EXPECT_EQ(42, clnt.find("/test/mirror/one", "test.One", "Int")->as<int>());
+        EXPECT_EQ(4711, clnt.find("/test/mirror/two", "test.Two", "Int")->as<int>());
+        EXPECT_NE(nullptr, clnt.find("/test/mirror/two", "test.Three"));
+        EXPECT_EQ(nullptr, clnt.find("/test/mirror/two", "test.One"));
+        EXPECT_EQ(nullptr, clnt.find("/test/mirror/three"));
+
+        o.Int = 7;
+    };
+
+    clnt.changed = [&](const simppl::dbus::ObjectPath& path, const std::string& iface){
+        EXPECT_EQ("/test/mirror/one", path.path);
+        EXPECT_EQ("test.One", iface);
+
+        if (++changes == 1)
+        {
+            EXPECT_EQ(7, clnt.find(path, iface, "Int")->as<int>());
+            EXPECT_EQ("Hallo", clnt.find(path, iface, "Str")->as<std::string>());
+
+            mgr.remove_managed_object(&t);
+        }
+    };
+
+    clnt.removed = [&](const simppl::dbus::ObjectPath& path){
+        EXPECT_EQ("/test/mirror/two", path.path);
+        EXPECT_EQ(nullptr, clnt.find(path));
+        EXPECT_EQ(1u, clnt.objects().size());
+
+        mgr.add_managed_object(&t);
+    };
+
+    clnt.added = [&](const simppl::dbus::ObjectPath& path){
+        EXPECT_EQ("/test/mirror/two", path.path);
+        EXPECT_EQ(2u, clnt.objects().size());
+        EXPECT_EQ(3.1415, clnt.find(path, "test.Two", "Double")->as<double>());
+
+        s.stop();
+    };
+
+    s.run();
+
+    EXPECT_EQ(1, changes);
+}
+
+
+TEST(ObjectManager, client_ignores_other_services)
+{
+    simppl::dbus::Dispatcher s("bus:session");
+
+    simppl::dbus::Skeleton<org::freedesktop::DBus::ObjectManager> mgr(s, "test.owner.a", "/");
+
+    simppl::dbus::Skeleton<test::One> o(s, "test.owner.a", "/test/owner/one");
+    o.Str = "Hallo";
+    o.Int = 42;
+
+    mgr.add_managed_object(&o);
+
+    // another service exporting an object under the same path
+    simppl::dbus::Dispatcher s2("bus:session");
+
+    simppl::dbus::Skeleton<test::One> other(s2, "test.owner.b", "/test/owner/one");
+    other.Str = "Welt";
+    other.Int = 1;
+
+    std::thread t([&s2](){ s2.run(); });
+
+    simppl::dbus::ObjectManagerClient clnt(s, "test.owner.a", "/");
+    simppl::dbus::Stub<test::One> ostub(s, "test.owner.b", "/test/owner/one");
+
+    int changes = 0;
+
+    clnt.synced = [&](simppl::dbus::ConnectionState){
+        s2.post([&](){ other.Int = 7; });
+    };
+
+    // the change of the other service reached this connection
+    ostub.Int.attach() >> [&](const simppl::dbus::CallState&, int i){
+        if (i == 7)
+            o.Int = 8;
+    };
+
+    clnt.changed = [&](const simppl::dbus::ObjectPath& path, const std::string& iface){
+        ++changes;
+
+        EXPECT_EQ(8, clnt.find(path, iface, "Int")->as<int>());
+        s.stop();
+    };
+
+    s.run();
+
+    s2.stop();
+    t.join();
+
+    EXPECT_EQ(1, changes);
+}
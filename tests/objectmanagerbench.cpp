@@ -0,0 +1,185 @@
+#include "simppl/skeleton.h"
+#include "simppl/stub.h"
+#include "simppl/interface.h"
+#include "simppl/dispatcher.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/**
+ * Benchmark of the startup and teardown of an object manager with many
+ * objects: adding and removing the objects one by one versus in a batch.
+ * The times include the delivery of all signals to a subscriber, the
+ * subscriber's eventloop iterations are its wakeups. Not a test, run it manually within a session bus, e.g. via
+ * dbus-run-session ./objectmanagerbench
+ */
+
+namespace test
+{
+
+INTERFACE(Bench)
+{
+   Property<std::string> Str;
+   Property<int>         Int;
+
+   Bench()
+    : INIT(Str)
+    , INIT(Int)
+   {}
+};
+
+}   // namespace test
+
+
+namespace
+{
+
+typedef simppl::dbus::Skeleton<test::Bench> object_type;
+
+
+double ms_since(std::chrono::steady_clock::time_point start)
+{
+   return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+/// counts the signals in its own thread
+struct Subscriber
+{
+   Subscriber()
+    : disp_("bus:session")
+    , stub_(disp_, "test.bench", "/")
+    , signals_(0)
+   {
+      stub_.InterfacesAdded.attach() >> [this](const simppl::dbus::ObjectPath&, const std::map<std::string, std::map<std::string, simppl::dbus::Any>>&){
+         ++signals_;
+      };
+
+      stub_.InterfacesRemoved.attach() >> [this](const simppl::dbus::ObjectPath&, const std::vector<std::string>&){
+         ++signals_;
+      };
+
+      thread_ = std::thread([this](){ disp_.run(); });
+   }
+
+   ~Subscriber()
+   {
+      disp_.stop();
+      thread_.join();
+   }
+
+   /// @return the eventloop iterations until count signals arrived
+   uint64_t wait(int count)
+   {
+      uint64_t start = disp_.statistics().iterations;
+
+      while(signals_ < count)
+         std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+      signals_ = 0;
+      return disp_.statistics().iterations - start;
+   }
+
+   simppl::dbus::Dispatcher disp_;
+   simppl::dbus::Stub<org::freedesktop::DBus::ObjectManager> stub_;
+   std::atomic_int signals_;
+   std::thread thread_;
+};
+
+
+/// run the eventloop until all deferred signals are sent out
+void drain(simppl::dbus::Dispatcher& d)
+{
+   d.post([&d](){ d.stop(); });
+   d.run();
+
+   dbus_connection_flush(&d.connection());
+}
+
+
+void run(std::size_t count, bool batched)
+{
+   simppl::dbus::Dispatcher d("bus:session");
+   simppl::dbus::Skeleton<org::freedesktop::DBus::ObjectManager> mgr(d, "test.bench", "/");
+
+   Subscriber sub;
+
+   // let the subscriber's signal registration settle
+   std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+   auto start = std::chrono::steady_clock::now();
+
+   std::vector<std::unique_ptr<object_type>> objs;
+   objs.reserve(count);
+
+   for (std::size_t i = 0; i < count; ++i)
+   {
+      objs.emplace_back(new object_type(d, "test.bench", "/test/bench/" + std::to_string(i)));
+      objs.back()->Str = "Hallo";
+      objs.back()->Int = i;
+   }
+
+   double construct = ms_since(start);
+   start = std::chrono::steady_clock::now();
+
+   if (batched)
+   {
+      mgr.add_managed_objects(objs.begin(), objs.end());
+   }
+   else
+   {
+      for (auto& obj : objs)
+         mgr.add_managed_object(obj.get());
+   }
+
+   drain(d);
+   uint64_t add_wakeups = sub.wait(count);
+
+   double add = ms_since(start);
+   start = std::chrono::steady_clock::now();
+
+   if (batched)
+   {
+      mgr.remove_managed_objects(objs.begin(), objs.end());
+   }
+   else
+   {
+      for (auto& obj : objs)
+         mgr.remove_managed_object(obj.get());
+   }
+
+   drain(d);
+   uint64_t remove_wakeups = sub.wait(count);
+
+   double remove = ms_since(start);
+   start = std::chrono::steady_clock::now();
+
+   objs.clear();
+
+   double destruct = ms_since(start);
+
+   printf("%8zu %8s %14.1f %10.1f %10llu %11.1f %10llu %14.1f\n", count, batched ? "batched" : "single",
+      construct, add, (unsigned long long)add_wakeups, remove, (unsigned long long)remove_wakeups, destruct);
+}
+
+}   // namespace
+
+
+int main()
+{
+   printf("%8s %8s %14s %10s %10s %11s %10s %14s\n", "objects", "mode", "construct [ms]", "add [ms]", "wakeups", "remove [ms]", "wakeups", "destruct [ms]");
+
+   for (std::size_t count : { 1000, 20000 })
+   {
+      run(count, false);
+      run(count, true);
+   }
+
+   return 0;
+}
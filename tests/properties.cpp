@@ -888,3 +888,76 @@ TEST(Properties, via_properties_interface)
    t.join();
 }
 
+
+
+/// objects of the same type share the interface table but not the values
+TEST(Properties, shared_interface_table)
+{
+   simppl::dbus::Dispatcher sd("bus:session");
+
+   Server s1(sd, "s1");
+   Server s2(sd, "s2");
+   s2.data = 42;
+
+   std::thread t([&sd](){
+      sd.run();
+   });
+
+   simppl::dbus::Dispatcher d;
+
+   simppl::dbus::Stub<Properties> c1(d, "s1");
+   simppl::dbus::Stub<Properties> c2(d, "s2");
+
+   EXPECT_EQ(4711, c1.data.get());
+   EXPECT_EQ(42, c2.data.get());
+
+   int ival = 0;
+   c2.data >> [&ival](const simppl::dbus::CallState&, int i) { ival = i; };
+   c2.get_all_properties();
+
+   EXPECT_EQ(42, ival);
+
+   sd.stop();
+   t.join();
+}
+
+
+TEST(Properties, getall_cache)
+{
+   simppl::dbus::Dispatcher sd("bus:session");
+
+   Server s(sd, "cache");
+   s.parallel.on_read([&s](){ return ++s.i_; }, true);
+
+   std::thread t([&sd](){
+      sd.run();
+   });
+
+   simppl::dbus::Dispatcher d;
+
+   simppl::dbus::Stub<org::freedesktop::DBus::Properties> c(d, "test.Properties.cache", "/test/Properties/cache");
+   simppl::dbus::Stub<Properties> c1(d, "cache");
+
+   auto result = c.GetAll("test.Properties");
+   EXPECT_EQ(1, result["parallel"].as<int>());
+
+   // served from the cache
+   result = c.GetAll("test.Properties");
+   EXPECT_EQ(1, result["parallel"].as<int>());
+   EXPECT_EQ(2u, (result["props"].as<std::map<ident_t, std::string>>().size()));
+
+   // a value change rebuilds the reply
+   c1.data.set(42);
+
+   result = c.GetAll("test.Properties");
+   EXPECT_EQ(2, result["parallel"].as<int>());
+   EXPECT_EQ(42, result["data"].as<int>());
+
+   s.parallel.invalidate_cache();
+
+   result = c.GetAll("test.Properties");
+   EXPECT_EQ(3, result["parallel"].as<int>());
+
+   sd.stop();
+   t.join();
+}
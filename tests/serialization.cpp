@@ -6,7 +6,18 @@
 #include "simppl/interface.h"
 #include "simppl/string.h"
 #include "simppl/struct.h"
-
+#include "simppl/vector.h"
+#include "simppl/map.h"
+#include "simppl/tuple.h"
+#include "simppl/variant.h"
+#include "simppl/any.h"
+#include "simppl/objectpath.h"
+#include "simppl/filedescriptor.h"
+#include "simppl/wstring.h"
+#include "simppl/lazy.h"
+#include "simppl/detail/wire.h"
+
+#include <cstring>
 #include <thread>
 
 
@@ -42,6 +53,18 @@ struct TestStruct2
 };
 
 
+struct Sample
+{
+   typedef typename
+         simppl::dbus::make_serializer<int32_t, int32_t, double>::type
+      serializer_type;
+
+   int32_t id;
+   int32_t flags;
+   double value;
+};
+
+
 #if SIMPPL_HAVE_BOOST_FUSION
 struct TestStruct3
 {
@@ -59,6 +82,7 @@ INTERFACE(Serialization)
 
    Method<in<TestStruct>, out<TestStruct>> echo;
    Method<in<TestStruct2>, out<TestStruct2>> echo2;
+   Method<in<std::string>, in<simppl::dbus::Lazy<std::vector<TestStruct2>>>, out<int>> route;
    
 #if SIMPPL_HAVE_BOOST_FUSION
    Method<in<TestStruct3>, out<TestStruct3>> echo3;
@@ -69,6 +93,7 @@ INTERFACE(Serialization)
     : INIT(stop)
     , INIT(echo)
     , INIT(echo2)
+    , INIT(route)
 #if SIMPPL_HAVE_BOOST_FUSION
     , INIT(echo3)
 #endif
@@ -171,6 +196,19 @@ struct Server : simppl::dbus::Skeleton<Serialization>
          
          respond_with(echo2(s));
       };
+
+
+      route >> [this](const std::string& key, const simppl::dbus::Lazy<std::vector<TestStruct2>>& payload)
+      {
+         EXPECT_TRUE(payload.deferred());
+
+         if (key == "drop")
+         {
+            respond_with(route(-1));
+         }
+         else
+            respond_with(route(payload.get().size()));
+      };
       
 #if SIMPPL_HAVE_BOOST_FUSION
       echo3 >> [this](const TestStruct3& s)
@@ -189,6 +227,95 @@ struct Server : simppl::dbus::Skeleton<Serialization>
 }   // anonymous namespace
 
 
+TEST(Serialization, signatures)
+{
+   using namespace simppl::dbus;
+
+   static_assert(Codec<std::vector<std::map<std::string, int>>>::signature().size() == 6);
+   EXPECT_STREQ("aa{si}", (Codec<std::vector<std::map<std::string, int>>>::signature().c_str()));
+
+   EXPECT_STREQ("(iis)", Codec<TestStruct2>::signature().c_str());
+   EXPECT_STREQ("(ids)", (Codec<std::tuple<int, double, std::string>>::signature().c_str()));
+   EXPECT_STREQ("{ob}", (Codec<std::pair<ObjectPath, bool>>::signature().c_str()));
+   EXPECT_STREQ("a{sv}", (Codec<std::map<std::string, std::variant<int, std::string>>>::signature().c_str()));
+   EXPECT_STREQ("av", Codec<std::vector<Any>>::signature().c_str());
+   EXPECT_STREQ("(hau)", (Codec<std::tuple<FileDescriptor, std::wstring>>::signature().c_str()));
+#if SIMPPL_HAVE_BOOST_FUSION
+   EXPECT_STREQ("a(iis)", Codec<std::vector<TestStruct3>>::signature().c_str());
+#endif
+
+   // user codecs without compile-time signature fall back to the stream interface
+   static_assert(!detail::has_signature<Codec<std::vector<TestStruct>>>::value);
+   EXPECT_STREQ("a(isi)", detail::type_signature<std::vector<TestStruct>>());
+   EXPECT_STREQ("a{s(iis)}", (detail::type_signature<std::map<std::string, TestStruct2>>()));
+}
+
+
+TEST(Serialization, fixed_arrays)
+{
+   using namespace simppl::dbus;
+
+   std::unique_ptr<DBusMessage, void(*)(DBusMessage*)> msg(dbus_message_new_signal("/a/b", "a.b", "c"), &dbus_message_unref);
+
+   std::vector<double> d{ 1.5, 2.5, 3.5 };
+   std::vector<uint8_t> b{ 1, 2, 255 };
+   std::vector<int> empty;
+   std::wstring w(L"Hello world");
+
+   DBusMessageIter iter;
+   dbus_message_iter_init_append(msg.get(), &iter);
+   encode(iter, d, b, empty, w, d);
+
+   EXPECT_STREQ("adayaiauad", dbus_message_get_signature(msg.get()));
+
+   std::vector<double> d2;
+   std::vector<uint8_t> b2;
+   std::vector<int> empty2{ 42 };
+   std::wstring w2;
+
+   dbus_message_iter_init(msg.get(), &iter);
+   decode(iter, d2, b2, empty2, w2);
+
+   EXPECT_EQ(d, d2);
+   EXPECT_EQ(b, b2);
+   EXPECT_TRUE(empty2.empty());
+   EXPECT_EQ(w, w2);
+
+   // element type mismatch
+   std::vector<int64_t> i;
+   EXPECT_THROW(decode(iter, i), DecoderError);
+}
+
+
+TEST(Serialization, containers)
+{
+   using namespace simppl::dbus;
+
+   std::unique_ptr<DBusMessage, void(*)(DBusMessage*)> msg(dbus_message_new_signal("/a/b", "a.b", "c"), &dbus_message_unref);
+
+   std::vector<TestStruct2> v{ { 1, 2, "Hello" }, { 3, 4, "World" } };
+   std::map<std::string, std::vector<std::string>> m{ { "a", { "b", "c" } }, { "d", {} } };
+
+   DBusMessageIter iter;
+   dbus_message_iter_init_append(msg.get(), &iter);
+   encode(iter, v, m);
+
+   // decoding replaces any former content
+   std::vector<TestStruct2> v2{ { 5, 6, "Bye" } };
+   std::map<std::string, std::vector<std::string>> m2{ { "x", { "y" } } };
+
+   dbus_message_iter_init(msg.get(), &iter);
+   decode(iter, v2, m2);
+
+   ASSERT_EQ(2u, v2.size());
+   EXPECT_EQ(3, v2[1].i);
+   EXPECT_EQ(4, v2[1].j);
+   EXPECT_EQ(std::string("World"), v2[1].str);
+
+   EXPECT_EQ(m, m2);
+}
+
+
 TEST(Serialization, user_codec)
 {
    simppl::dbus::Dispatcher d("bus:session");
@@ -273,3 +400,256 @@ TEST(Serialization, fusion)
    t.join();
 }
 #endif
+
+
+TEST(Serialization, lazy)
+{
+   simppl::dbus::Dispatcher d("bus:session");
+   
+   std::thread t([](){
+      simppl::dbus::Dispatcher d("bus:session");
+      Server s(d, "ts");
+      d.run();
+   });
+
+   simppl::dbus::Stub<Serialization> stub(d, "ts");
+
+   // wait for server to get ready
+   std::this_thread::sleep_for(100ms);
+
+   std::vector<TestStruct2> payload{ { 1, 2, "Hello" }, { 3, 4, "World" } };
+
+   EXPECT_EQ(-1, stub.route("drop", payload));
+   EXPECT_EQ(2, stub.route("take", payload));
+
+   // large enough to be sent in wire format
+   std::vector<TestStruct2> large(1000, TestStruct2{ 1, 2, "Hello World" });
+   EXPECT_EQ(1000, stub.route("take", large));
+   
+   stub.stop();   // stop server
+   t.join();
+}
+
+
+TEST(Serialization, lazy_decode)
+{
+   using namespace simppl::dbus;
+
+   std::unique_ptr<DBusMessage, void(*)(DBusMessage*)> msg(dbus_message_new_signal("/a/b", "a.b", "c"), &dbus_message_unref);
+
+   DBusMessageIter iter;
+   dbus_message_iter_init_append(msg.get(), &iter);
+   encode(iter, TestStruct2{ 1, 2, "Hello" }, 42);
+
+   Lazy<TestStruct2> s;
+   int i;
+
+   dbus_message_iter_init(msg.get(), &iter);
+   decode(iter, s, i);
+
+   // the argument was skipped
+   EXPECT_EQ(42, i);
+   EXPECT_TRUE(s.deferred());
+
+   // the copy holds the message
+   Lazy<TestStruct2> copy(s);
+   msg.reset();
+   s = Lazy<TestStruct2>();
+
+   EXPECT_EQ(std::string("Hello"), copy.get().str);
+   EXPECT_FALSE(copy.deferred());
+
+   // type mismatch is detected on decoding
+   msg.reset(dbus_message_new_signal("/a/b", "a.b", "c"));
+   dbus_message_iter_init_append(msg.get(), &iter);
+   encode(iter, 42);
+
+   dbus_message_iter_init(msg.get(), &iter);
+   EXPECT_THROW(decode(iter, s), DecoderError);
+
+   // a mismatch of an inner type is only detected on access, each time
+   msg.reset(dbus_message_new_signal("/a/b", "a.b", "c"));
+   dbus_message_iter_init_append(msg.get(), &iter);
+   encode(iter, std::make_tuple(1, 2, 3));
+
+   dbus_message_iter_init(msg.get(), &iter);
+   decode(iter, s);
+
+   EXPECT_THROW(s.get(), DecoderError);
+   EXPECT_THROW(s.get(), DecoderError);
+   EXPECT_TRUE(s.deferred());
+}
+
+
+TEST(Serialization, wire_encoding)
+{
+   using namespace simppl::dbus;
+
+   static_assert(detail::has_wire_encoding<int, std::string, std::vector<TestStruct2>, std::map<int, std::variant<int, std::string>>>::value);
+   static_assert(!detail::has_wire_encoding<TestStruct>::value, "user codecs have no wire encoding");
+   static_assert(!detail::has_wire_encoding<std::vector<TestStruct>>::value, "user codecs have no wire encoding");
+
+   std::vector<TestStruct2> v{ { 1, 2, "Hello" }, { 3, 4, "World" } };
+   std::map<std::string, std::vector<std::string>> m{ { "a", { "b", "c" } }, { "d", {} } };
+   std::map<int, std::variant<int, std::string, std::vector<double>>> vm{ { 1, 42 }, { 2, std::string("Hello") }, { 3, std::vector<double>{ 0.5 } } };
+   std::vector<int16_t> empty;
+
+   message_ptr_t msg = make_message(dbus_message_new_signal("/a/b", "a.b", "c"));
+
+   DBusMessageIter iter;
+   dbus_message_iter_init_append(msg.get(), &iter);
+   encode(iter, (uint8_t)1, v, true, m, empty, ObjectPath("/a/b"), vm, 3.1415);
+
+   message_ptr_t tmpl = make_message(dbus_message_new_signal("/a/b", "a.b", "c"));
+   message_ptr_t wmsg = detail::wire_encode(*tmpl, (uint8_t)1, v, true, m, empty, ObjectPath("/a/b"), vm, 3.1415);
+
+   EXPECT_STREQ(dbus_message_get_signature(msg.get()), dbus_message_get_signature(wmsg.get()));
+   EXPECT_EQ(detail::wire_body(*msg), detail::wire_body(*wmsg));
+
+   // the header is identical too
+   auto marshal = [](DBusMessage* m){
+      char* data = nullptr;
+      int len = 0;
+      dbus_message_marshal(m, &data, &len);
+
+      std::string rc(data, len);
+      dbus_free(data);
+
+      return rc;
+   };
+
+   dbus_message_set_serial(msg.get(), 1);
+   dbus_message_set_serial(wmsg.get(), 1);
+
+   EXPECT_EQ(marshal(msg.get()), marshal(wmsg.get()));
+
+   // and decodes the same
+   std::vector<TestStruct2> v2;
+   std::map<std::string, std::vector<std::string>> m2;
+
+   dbus_message_iter_init(wmsg.get(), &iter);
+   dbus_message_iter_next(&iter);
+   decode(iter, v2);
+   dbus_message_iter_next(&iter);
+   decode(iter, m2);
+
+   ASSERT_EQ(2u, v2.size());
+   EXPECT_EQ(std::string("World"), v2[1].str);
+   EXPECT_EQ(m, m2);
+
+   // the path is chosen by a lower bound of the body size before encoding
+   std::vector<std::string> strings(1000, "Hello World");
+
+   detail::WireWriter w;
+   encode(w, strings);
+
+   EXPECT_LE(detail::wire_size_hint(strings), w.size());
+   EXPECT_GE(detail::wire_size_hint(strings), detail::wire_encoding_threshold);
+   EXPECT_LT(detail::wire_size_hint(v) + detail::wire_size_hint(m), detail::wire_encoding_threshold);
+
+   message_ptr_t smsg = make_message(dbus_message_new_signal("/a/b", "a.b", "c"));
+   dbus_message_iter_init_append(smsg.get(), &iter);
+   encode(iter, strings);
+
+   message_ptr_t cmsg = make_message(dbus_message_new_signal("/a/b", "a.b", "c"));
+   detail::encode_message(cmsg, strings);
+
+   EXPECT_EQ(detail::wire_body(*smsg), detail::wire_body(*cmsg));
+}
+
+
+TEST(Serialization, wire_layout)
+{
+   using namespace simppl::dbus;
+
+   struct Padded
+   {
+      typedef make_serializer<int32_t, double>::type serializer_type;
+
+      int32_t i;
+      double d;
+   };
+
+   struct Tail
+   {
+      typedef make_serializer<int32_t, int32_t, int32_t>::type serializer_type;
+
+      int32_t i, j, k;
+   };
+
+   static_assert(detail::is_wire_layout_compatible<Sample>::value);
+   static_assert(!detail::is_wire_layout_compatible<Padded>::value, "padding between members");
+   static_assert(!detail::is_wire_layout_compatible<Tail>::value, "padding to the next element");
+   static_assert(!detail::is_wire_layout_compatible<TestStruct2>::value, "not fixed-size");
+
+   std::vector<Sample> samples;
+   for (int i = 0; i < 100; ++i)
+      samples.push_back(Sample{ i, i * 2, i * 0.5 });
+
+   std::vector<Sample> empty;
+
+   message_ptr_t msg = make_message(dbus_message_new_signal("/a/b", "a.b", "c"));
+
+   DBusMessageIter iter;
+   dbus_message_iter_init_append(msg.get(), &iter);
+   encode(iter, (uint8_t)1, samples, empty, samples[3]);
+
+   // copied as a whole but byte-identical
+   message_ptr_t tmpl = make_message(dbus_message_new_signal("/a/b", "a.b", "c"));
+   message_ptr_t wmsg = detail::wire_encode(*tmpl, (uint8_t)1, samples, empty, samples[3]);
+
+   EXPECT_EQ(detail::wire_body(*msg), detail::wire_body(*wmsg));
+
+   std::vector<Sample> samples2;
+
+   dbus_message_iter_init(wmsg.get(), &iter);
+   dbus_message_iter_next(&iter);
+   decode(iter, samples2);
+
+   ASSERT_EQ(100u, samples2.size());
+   EXPECT_EQ(99, samples2[99].id);
+   EXPECT_EQ(198, samples2[99].flags);
+   EXPECT_EQ(49.5, samples2[99].value);
+}
+
+
+TEST(Serialization, invalid_args)
+{
+   simppl::dbus::Dispatcher d("bus:session");
+   
+   std::thread t([](){
+      simppl::dbus::Dispatcher d("bus:session");
+      Server s(d, "ts");
+      d.run();
+   });
+
+   simppl::dbus::Stub<Serialization> stub(d, "ts");
+
+   // wait for server to get ready
+   std::this_thread::sleep_for(100ms);
+
+   DBusError err;
+   dbus_error_init(&err);
+
+   DBusConnection* conn = dbus_bus_get_private(DBUS_BUS_SESSION, &err);
+   ASSERT_NE(nullptr, conn);
+
+   // echo2 expects (iis), trailing arguments were silently ignored before
+   std::unique_ptr<DBusMessage, void(*)(DBusMessage*)> msg(dbus_message_new_method_call("test.Serialization.ts", "/test/Serialization/ts", "test.Serialization", "echo2"), &dbus_message_unref);
+
+   DBusMessageIter iter;
+   dbus_message_iter_init_append(msg.get(), &iter);
+   simppl::dbus::encode(iter, TestStruct2{ 42, 7, "Hello World" }, 1);
+
+   DBusMessage* reply = dbus_connection_send_with_reply_and_block(conn, msg.get(), 1000, &err);
+
+   EXPECT_EQ(nullptr, reply);
+   EXPECT_STREQ(DBUS_ERROR_INVALID_ARGS, err.name);
+
+   dbus_error_free(&err);
+   dbus_connection_close(conn);
+   dbus_connection_unref(conn);
+
+   stub.stop();   // stop server
+   t.join();
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include "simppl/stub.h"
+#include "simppl/skeleton.h"
+#include "simppl/dispatcher.h"
+#include "simppl/interface.h"
+#include "simppl/threadpool.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+using namespace std::literals::chrono_literals;
+
+using simppl::dbus::in;
+using simppl::dbus::out;
+
+
+namespace test {
+
+INTERFACE(Worker)
+{
+   Method<in<int>, out<int>> work;
+   Method<in<int>, out<int>> deferred;
+
+   inline
+   Worker()
+    : INIT(work)
+    , INIT(deferred)
+   {
+      // NOOP
+   }
+};
+
+}   // namespace
+
+using namespace test;
+
+
+namespace {
+
+
+struct Server : simppl::dbus::Skeleton<Worker>
+{
+   Server(simppl::dbus::Dispatcher& d, const char* rolename)
+    : simppl::dbus::Skeleton<Worker>(d, rolename)
+   {
+      // the higher the number the earlier the handler finishes
+      work >> [this](int i){
+         std::this_thread::sleep_for((10 - i) * 5ms);
+
+         std::lock_guard<std::mutex> lock(mutex_);
+         threads_.push_back(std::this_thread::get_id());
+
+         respond_with(work(i));
+      };
+
+      deferred >> [this](int i){
+         auto req = std::make_shared<simppl::dbus::ServerRequestDescriptor>(defer_response());
+
+         // answer from a completely different thread
+         std::thread([this, req, i](){
+            respond_on(*req, deferred(i));
+         }).detach();
+      };
+   }
+
+   std::mutex mutex_;
+   std::vector<std::thread::id> threads_;
+};
+
+
+}   // anonymous namespace
+
+
+TEST(ThreadPool, off_dispatcher_thread)
+{
+   simppl::dbus::ThreadPool pool(2);
+
+   simppl::dbus::Dispatcher d("bus:session");
+   simppl::dbus::Stub<Worker> stub(d, "s");
+
+   Server s(d, "s");
+   s.set_executor(&pool);
+
+   int result = 0;
+
+   stub.connected >> [&](simppl::dbus::ConnectionState st){
+      stub.work.async(9) >> [&](const simppl::dbus::CallState& state, int i){
+         EXPECT_TRUE((bool)state);
+         result = i;
+
+         d.stop();
+      };
+   };
+
+   d.run();
+
+   EXPECT_EQ(9, result);
+
+   ASSERT_EQ(1u, s.threads_.size());
+   EXPECT_NE(std::this_thread::get_id(), s.threads_[0]);
+}
+
+
+TEST(ThreadPool, ordered)
+{
+   simppl::dbus::ThreadPool pool(4);
+
+   simppl::dbus::Dispatcher d("bus:session");
+   simppl::dbus::Stub<Worker> stub(d, "s");
+
+   Server s(d, "s");
+   s.set_executor(&pool, true);
+
+   std::vector<int> results;
+
+   stub.connected >> [&](simppl::dbus::ConnectionState st){
+      for(int i=0; i<8; ++i)
+      {
+         auto& method = (i % 2) ? stub.deferred : stub.work;
+
+         method.async(i) >> [&](const simppl::dbus::CallState& state, int i){
+            EXPECT_TRUE((bool)state);
+            results.push_back(i);
+
+            if (results.size() == 8)
+               d.stop();
+         };
+      }
+   };
+
+   d.run();
+
+   ASSERT_EQ(8u, results.size());
+
+   for(int i=0; i<8; ++i)
+      EXPECT_EQ(i, results[i]);
+}
+
+
+TEST(ThreadPool, destroy_with_pending_requests)
+{
+   simppl::dbus::ThreadPool pool(1);
+
+   simppl::dbus::Dispatcher d("bus:session");
+   simppl::dbus::Stub<Worker> stub(d, "s");
+
+   std::unique_ptr<Server> s(new Server(d, "s"));
+   s->set_executor(&pool, true);
+
+   std::atomic<int> started(0);
+
+   // destroy the skeleton while the first handler runs and the others are queued
+   Server* self = s.get();
+
+   s->work >> [&, self](int i){
+      if (started++ == 0)
+      {
+         d.post([&](){
+            s.reset();
+            d.stop();
+         });
+      }
+
+      // the destructor waits for the handler
+      std::this_thread::sleep_for(50ms);
+      self->respond_with(self->work(i));
+   };
+
+   stub.connected >> [&](simppl::dbus::ConnectionState st){
+      for(int i=0; i<3; ++i)
+         stub.work.async(i) >> [](const simppl::dbus::CallState&, int){};
+   };
+
+   d.run();
+
+   EXPECT_FALSE(s);
+
+   // the queued handlers are dropped
+   std::this_thread::sleep_for(200ms);
+   EXPECT_EQ(1, started);
+}
@@ -310,3 +310,29 @@ TEST(Timeout, blocking_api)
    serverthread.join();
 }
 
+
+
+TEST(Timeout, stop_idle_loop)
+{
+   simppl::dbus::Dispatcher d;
+
+   std::thread loopthread([&d](){
+      d.run();
+   });
+
+   // let the loop block in an idle state
+   while(!d.is_running())
+      std::this_thread::sleep_for(1ms);
+
+   std::this_thread::sleep_for(200ms);
+
+   auto start = std::chrono::steady_clock::now();
+
+   d.stop();
+   loopthread.join();
+
+   // the idle loop blocks without timeout, so only the wakeup by stop()
+   // ends it; the bound is just generous for loaded machines
+   long millis = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+   EXPECT_LT(millis, 1000);
+}
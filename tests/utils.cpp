@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
 #include "simppl/detail/util.h"
+#include "simppl/detail/dispatchindex.h"
+
+#include <string>
+#include <vector>
 
 namespace test
 {
@@ -13,4 +17,43 @@ TEST(Utils, extract_interface)
    EXPECT_EQ(interface[0], "simppl.example.EchoService");
 }
 
+
+
+TEST(Utils, dispatch_index)
+{
+   using simppl::dbus::detail::DispatchIndex;
+
+   std::vector<std::string> names;
+   for (int i = 0; i < 100; ++i)
+      names.push_back("Method" + std::to_string(i));
+
+   DispatchIndex idx;
+   EXPECT_TRUE(idx.empty());
+
+   for (int i = 0; i < 100; ++i)
+   {
+      idx.insert(DispatchIndex::Method, "a.b", names[i].c_str(), 1, i);
+      idx.insert(DispatchIndex::Property, "a.b", names[i].c_str(), 1, -i);
+   }
+
+   // first one wins
+   idx.insert(DispatchIndex::Method, "a.b", "Method0", 2, 1000);
+
+   for (int i = 0; i < 100; ++i)
+   {
+      auto e = idx.find(DispatchIndex::Method, "a.b", names[i].c_str());
+      ASSERT_NE(nullptr, e);
+      EXPECT_EQ(i, e->offset_);
+      EXPECT_EQ(1, e->iface_id_);
+   }
+
+   EXPECT_EQ(nullptr, idx.find(DispatchIndex::Method, "a.bM", "ethod0"));
+   EXPECT_EQ(nullptr, idx.find(DispatchIndex::Method, "a.c", "Method0"));
+   EXPECT_EQ(nullptr, idx.find(DispatchIndex::Interface, "a.b", ""));
+   EXPECT_EQ(nullptr, idx.find(DispatchIndex::Method, "a.b", "Method100"));
+
+   idx.clear();
+   EXPECT_EQ(nullptr, idx.find(DispatchIndex::Method, "a.b", "Method0"));
+}
+
 }
@@ -0,0 +1,159 @@
+#include "simppl/vector.h"
+#include "simppl/map.h"
+#include "simppl/string.h"
+#include "simppl/struct.h"
+#include "simppl/detail/wire.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+
+/**
+ * Microbenchmark of building messages: writing the arguments in wire format
+ * into one buffer and demarshalling the message versus appending them value
+ * by value through the message iterators, and the choice between both by
+ * body size as done when sending. Not a test, run it manually.
+ */
+
+using namespace simppl::dbus;
+
+
+namespace
+{
+
+struct Entry
+{
+   typedef make_serializer<int, std::string, double, std::vector<uint8_t>>::type serializer_type;
+
+   int i;
+   std::string str;
+   double d;
+   std::vector<uint8_t> data;
+};
+
+
+/// memory layout equals the wire format, copied as a whole
+struct Sample
+{
+   typedef make_serializer<int32_t, int32_t, double>::type serializer_type;
+
+   int32_t id;
+   int32_t flags;
+   double value;
+};
+
+
+/// padding after the int, written member by member
+struct PaddedSample
+{
+   typedef make_serializer<int32_t, double>::type serializer_type;
+
+   int32_t id;
+   double value;
+};
+
+
+constexpr int rounds = 50;
+
+
+message_ptr_t make_template()
+{
+   return make_message(dbus_message_new_signal("/bench", "bench.Wire", "Data"));
+}
+
+
+template<typename T>
+void measure(const char* name, int count, const T& t)
+{
+   double iter_ms = 0;
+   double wire_ms = 0;
+   double chosen_ms = 0;
+
+   bool identical = true;
+
+   for (int i = 0; i < rounds; ++i)
+   {
+      auto start = std::chrono::steady_clock::now();
+
+      message_ptr_t msg1 = make_template();
+
+      for (int n = 0; n < count; ++n)
+      {
+         msg1 = make_template();
+
+         DBusMessageIter iter;
+         dbus_message_iter_init_append(msg1.get(), &iter);
+         encode(iter, t);
+      }
+
+      auto mid = std::chrono::steady_clock::now();
+
+      message_ptr_t msg2 = make_template();
+
+      for (int n = 0; n < count; ++n)
+         msg2 = detail::wire_encode(*make_template(), t);
+
+      auto mid2 = std::chrono::steady_clock::now();
+
+      message_ptr_t msg3 = make_template();
+
+      for (int n = 0; n < count; ++n)
+      {
+         msg3 = make_template();
+         detail::encode_message(msg3, t);
+      }
+
+      auto end = std::chrono::steady_clock::now();
+
+      iter_ms += std::chrono::duration<double, std::milli>(mid - start).count();
+      wire_ms += std::chrono::duration<double, std::milli>(mid2 - mid).count();
+      chosen_ms += std::chrono::duration<double, std::milli>(end - mid2).count();
+
+      identical &= detail::wire_body(*msg1) == detail::wire_body(*msg2) && detail::wire_body(*msg1) == detail::wire_body(*msg3);
+   }
+
+   if (!identical)
+      fprintf(stderr, "%s: bodies differ\n", name);
+
+   printf("%-20s %14.3f %14.3f %14.3f\n", name, iter_ms / rounds, wire_ms / rounds, chosen_ms / rounds);
+}
+
+}   // namespace
+
+
+int main()
+{
+   Entry entry{ 42, "Hello World", 3.1415, std::vector<uint8_t>(16, 0x55) };
+
+   std::vector<Entry> entries(10000, entry);
+
+   std::vector<Sample> samples(100000, Sample{ 1, 2, 3.1415 });
+   std::vector<PaddedSample> padded_samples(100000, PaddedSample{ 1, 3.1415 });
+
+   std::vector<std::string> strings(100000, "Hello World");
+
+   std::map<std::string, int> small_dict;
+   std::map<int, std::string> dict;
+
+   for (int i = 0; i < 10; ++i)
+      small_dict["key" + std::to_string(i)] = i;
+
+   for (int i = 0; i < 100000; ++i)
+      dict[i] = "Hello World";
+
+   printf("%-20s %14s %14s %14s\n", "", "iterator [ms]", "wire [ms]", "chosen [ms]");
+
+   measure("1000x (isday)", 1000, entry);
+   measure("1000x a{si} 10", 1000, small_dict);
+   measure("a(isday) 10k", 1, entries);
+   measure("a(iid) 100k", 1, samples);
+   measure("a(id) 100k", 1, padded_samples);
+   measure("as 100k", 1, strings);
+   measure("a{is} 100k", 1, dict);
+
+   return 0;
+}